@@ -8,6 +8,7 @@
 #include <wesos-builtin/Export.hh>
 #include <wesos-cpu/Target.hh>
 #include <wesos-cpu/Timing.hh>
+#include <wesos-cpu/Topology.hh>
 #include <wesos-kernconf/Parser.hh>
 #include <wesos-mem/MemoryEconomy.hh>
 #include <wesos-sync/MemoryOrder.hh>
@@ -149,6 +150,9 @@ namespace wesos::kern {
     //     assert::register_output_callback(nullptr, stdio_output_handler);
     // #endif
 
+    /* The boot CPU is CPU 0; application processors register themselves as they come up */
+    cpu::register_cpu(0);
+
     auto config_opt = kernconf::parse_kernel_config({configuration, configuration_len});
     assert_always(config_opt.isset() && "Failed to parse kernel config options");
 
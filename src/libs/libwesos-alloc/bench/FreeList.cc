@@ -0,0 +1,68 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+#include <vector>
+#include <wesos-alloc/FreeList.hh>
+
+#include "UnifiedBenchmark.hh"
+
+using namespace wesos;
+using namespace wesos::alloc;
+using namespace wesos::mem;
+using namespace wesos::mem::testing;
+
+static constexpr usize FRAGMENTED_POOL_SIZE = 64 * 1024 * 1024;
+static constexpr usize FRAGMENT_SIZE = 64;
+static constexpr usize REQUEST_SIZE = 512;
+
+static void deps_setup() {
+  wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+    std::cerr << "\n==========================================================================="
+                 "===========\n"
+              << "| Assertion Failed: \"" << message << "\";\n"
+              << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+              << "| File: \"" << source.file_name() << "\";\n"
+              << "============================================================================="
+                 "=========\n"
+              << std::endl;
+  });
+}
+
+/* Leaves `range(0)` small free chunks that cannot coalesce, then times requests none of them can serve */
+static void BM_FreeList_Fragmented(benchmark::State& state) {
+  deps_setup();
+
+  const auto fragments = usize(state.range(0));
+
+  std::vector<u8> storage(FRAGMENTED_POOL_SIZE);
+  auto mm = FreeList(View<u8>(storage.data(), storage.size()));
+
+  std::vector<void*> blocks;
+  for (usize i = 0; i < fragments * 2; i++) {
+    blocks.push_back(mm.allocate_bytes(FRAGMENT_SIZE, 8).unwrap());
+  }
+
+  for (usize i = 0; i < blocks.size(); i += 2) {
+    mm.deallocate_bytes(blocks[i], FRAGMENT_SIZE, 8);
+  }
+
+  usize alloc_count = 0;
+
+  for (auto x : state) {
+    auto ptr = mm.allocate_bytes(REQUEST_SIZE, 8);
+    benchmark::DoNotOptimize(ptr);
+    alloc_count += ptr.isset();
+    mm.deallocate_bytes(ptr, REQUEST_SIZE, 8);
+  }
+
+  state.SetItemsProcessed(isize(alloc_count));
+}
+
+BENCHMARK(BM_FreeList_Fragmented)->RangeMultiplier(4)->Range(16, 64 * 1024);
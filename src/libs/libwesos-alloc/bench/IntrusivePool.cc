@@ -10,17 +10,23 @@
 #include <cstdarg>
 #include <cstdio>
 #include <iostream>
+#include <wesos-alloc/AtomicIntrusivePool.hh>
 #include <wesos-alloc/IntrusivePool.hh>
+#include <wesos-mem/AtomicResource.hh>
+#include <wesos-mem/StaticResource.hh>
 #include <wesos-mem/TracingResource.hh>
 
 #include "UnifiedBenchmark.hh"
 
 using namespace wesos;
+using namespace wesos::alloc;
 using namespace wesos::mem;
 using namespace wesos::mem::testing;
 
 using ClampedAlign = ClampMost<PowerOfTwo<usize>, 4096ULL>;
 
+static constexpr int THREADED_MAX_THREADS = 16;
+
 static void deps_setup() {
   wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
     std::cerr << "\n==========================================================================="
@@ -120,6 +126,21 @@ static void BM_IntrusivePool_Mono_Creation(benchmark::State& state) {
   }
 }
 
+static void BM_IntrusivePool_Large_Creation(benchmark::State& state) {
+  deps_setup();
+
+  constexpr IntrusivePool::ObjectSize object_size = 64;
+  constexpr usize object_align = 16;
+  std::vector<u8> storage(usize(state.range(0)));
+
+  for (auto x : state) {
+    auto mm = IntrusivePool(object_size, object_align, View<u8>(storage.data(), storage.size()));
+    benchmark::DoNotOptimize(mm.allocate_bytes(object_size, object_align));
+  }
+
+  state.SetBytesProcessed(isize(state.iterations()) * state.range(0));
+}
+
 static void BM_IntrusivePool_Mono_Synchronized(benchmark::State& state) {
   deps_setup();
 
@@ -168,9 +189,149 @@ static void BM_IntrusivePool_Mono_Unsynchronized(benchmark::State& state) {
   state.SetBytesProcessed(isize(alloc_count * object_size));
 }
 
+static void BM_IntrusivePool_Mono_Threaded(benchmark::State& state) {
+  struct MockData {
+    u64 m_data;
+    MockData *m_prev, *m_next;
+  };
+
+  constexpr IntrusivePool::ObjectSize object_size = sizeof(MockData);
+  constexpr usize object_align = alignof(MockData);
+  [[gnu::aligned(object_align)]] static Array<u8, object_size.unwrap() * THREADED_MAX_THREADS> storage;
+  static auto pool = IntrusivePool(object_size, object_align, storage.as_view());
+  static auto mm = AtomicResource(pool);
+
+  if (state.thread_index() == 0) {
+    deps_setup();
+  }
+
+  usize alloc_count = 0;
+  const auto options = BenchmarkOptions(object_size, object_size, object_align, object_align);
+
+  for (auto x : state) {
+    allocator_benchmark(mm, false, options, alloc_count);
+  }
+
+  state.SetItemsProcessed(isize(alloc_count));
+  state.SetBytesProcessed(isize(alloc_count * object_size));
+}
+
+static void BM_AtomicIntrusivePool_Mono_Threaded(benchmark::State& state) {
+  struct MockData {
+    u64 m_data;
+    MockData *m_prev, *m_next;
+  };
+
+  constexpr AtomicIntrusivePool::ObjectSize object_size = sizeof(MockData);
+  constexpr usize object_align = alignof(MockData);
+  [[gnu::aligned(object_align)]] static Array<u8, object_size.unwrap() * THREADED_MAX_THREADS> storage;
+  static auto mm = AtomicIntrusivePool(object_size, object_align, storage.as_view());
+
+  if (state.thread_index() == 0) {
+    deps_setup();
+  }
+
+  usize alloc_count = 0;
+  const auto options = BenchmarkOptions(object_size, object_size, object_align, object_align);
+
+  for (auto x : state) {
+    allocator_benchmark(mm, false, options, alloc_count);
+  }
+
+  state.SetItemsProcessed(isize(alloc_count));
+  state.SetBytesProcessed(isize(alloc_count * object_size));
+}
+
+template <class Resource>
+static void intrusive_pool_dispatch(benchmark::State& state) {
+  deps_setup();
+
+  struct MockData {
+    u64 m_data;
+    MockData *m_prev, *m_next;
+  };
+
+  constexpr IntrusivePool::ObjectSize object_size = sizeof(MockData);
+  constexpr usize object_align = alignof(MockData);
+  [[gnu::aligned(object_align)]] Array<u8, object_size.unwrap()> storage;
+
+  auto pool = IntrusivePool(object_size, object_align, storage.as_view());
+  auto mm = StaticResource<Resource>(pool);
+
+  for (auto x : state) {
+    auto ptr = mm.allocate_bytes(object_size, object_align);
+    benchmark::DoNotOptimize(ptr);
+    mm.deallocate_bytes(ptr, object_size, object_align);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_IntrusivePool_Dispatch_Dynamic(benchmark::State& state) {
+  intrusive_pool_dispatch<MemoryResourceProtocol>(state);
+}
+
+static void BM_IntrusivePool_Dispatch_Static(benchmark::State& state) { intrusive_pool_dispatch<IntrusivePool>(state); }
+
+static constexpr usize BULK_BATCH_SIZE = 32;
+
+static void BM_IntrusivePool_Atomic_Batch_Single(benchmark::State& state) {
+  deps_setup();
+
+  constexpr IntrusivePool::ObjectSize object_size = 32;
+  constexpr usize object_align = 16;
+  alignas(object_align) static Array<u8, object_size.unwrap() * BULK_BATCH_SIZE> storage;
+
+  auto pool = IntrusivePool(object_size, object_align, storage.as_view());
+  auto mm = AtomicResource(pool);
+  Array<void*, BULK_BATCH_SIZE> batch;
+
+  for (auto x : state) {
+    for (auto& ptr : batch.as_view()) {
+      ptr = mm.allocate_bytes(object_size, object_align).unwrap();
+    }
+
+    benchmark::DoNotOptimize(batch);
+
+    for (auto* ptr : batch.as_view()) {
+      mm.deallocate_bytes(ptr, object_size, object_align);
+    }
+  }
+
+  state.SetItemsProcessed(isize(state.iterations() * BULK_BATCH_SIZE));
+}
+
+static void BM_IntrusivePool_Atomic_Batch_Bulk(benchmark::State& state) {
+  deps_setup();
+
+  constexpr IntrusivePool::ObjectSize object_size = 32;
+  constexpr usize object_align = 16;
+  alignas(object_align) static Array<u8, object_size.unwrap() * BULK_BATCH_SIZE> storage;
+
+  auto pool = IntrusivePool(object_size, object_align, storage.as_view());
+  auto mm = AtomicResource(pool);
+  Array<void*, BULK_BATCH_SIZE> batch;
+
+  for (auto x : state) {
+    const auto count = mm.allocate_bulk(batch.as_view(), object_size, object_align);
+    benchmark::DoNotOptimize(batch);
+
+    mm.deallocate_bulk(batch.as_view().subview(0, count), object_size, object_align);
+  }
+
+  state.SetItemsProcessed(isize(state.iterations() * BULK_BATCH_SIZE));
+}
+
 BENCHMARK(BM_IntrusivePool_Evo_Creation);
 BENCHMARK(BM_IntrusivePool_Evo_Synchronized);
 BENCHMARK(BM_IntrusivePool_Evo_Unsynchronized);
 BENCHMARK(BM_IntrusivePool_Mono_Creation);
+BENCHMARK(BM_IntrusivePool_Large_Creation)->RangeMultiplier(16)->Range(4096, 64 << 20);
 BENCHMARK(BM_IntrusivePool_Mono_Synchronized);
 BENCHMARK(BM_IntrusivePool_Mono_Unsynchronized);
+BENCHMARK(BM_IntrusivePool_Mono_Threaded)->ThreadRange(1, THREADED_MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_AtomicIntrusivePool_Mono_Threaded)->ThreadRange(1, THREADED_MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_IntrusivePool_Dispatch_Dynamic);
+BENCHMARK(BM_IntrusivePool_Dispatch_Static);
+BENCHMARK(BM_IntrusivePool_Atomic_Batch_Single);
+BENCHMARK(BM_IntrusivePool_Atomic_Batch_Bulk);
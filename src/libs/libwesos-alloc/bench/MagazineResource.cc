@@ -0,0 +1,82 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+#include <wesos-alloc/MagazineResource.hh>
+#include <wesos-alloc/SlabResource.hh>
+#include <wesos-mem/AtomicResource.hh>
+
+#include "UnifiedBenchmark.hh"
+
+using namespace wesos;
+using namespace wesos::alloc;
+using namespace wesos::mem;
+using namespace wesos::mem::testing;
+
+static constexpr usize THREADED_SIZE_MIN = 8;
+static constexpr usize THREADED_SIZE_MAX = 256;
+static constexpr usize THREADED_ALIGN_MIN = 8;
+static constexpr usize THREADED_ALIGN_MAX = 16;
+static constexpr int THREADED_MAX_THREADS = 16;
+
+static void deps_setup() {
+  wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+    std::cerr << "\n==========================================================================="
+                 "===========\n"
+              << "| Assertion Failed: \"" << message << "\";\n"
+              << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+              << "| File: \"" << source.file_name() << "\";\n"
+              << "============================================================================="
+                 "=========\n"
+              << std::endl;
+  });
+}
+
+/* One resource shared by every thread of every run; only the front-end differs. */
+
+static void BM_AtomicResource_Threads(benchmark::State& state) {
+  static HostResource backing;
+  static SlabResource slab(backing);
+  static AtomicResource mm(slab);
+
+  if (state.thread_index() == 0) {
+    deps_setup();
+  }
+
+  usize alloc_count = 0;
+  const auto options = BenchmarkOptions(THREADED_SIZE_MIN, THREADED_SIZE_MAX, THREADED_ALIGN_MIN, THREADED_ALIGN_MAX);
+
+  for (auto x : state) {
+    allocator_benchmark(mm, false, options, alloc_count);
+  }
+
+  state.SetItemsProcessed(isize(alloc_count));
+}
+
+static void BM_MagazineResource_Threads(benchmark::State& state) {
+  static HostResource backing;
+  static SlabResource slab(backing);
+  static MagazineResource mm(slab);
+
+  if (state.thread_index() == 0) {
+    deps_setup();
+  }
+
+  usize alloc_count = 0;
+  const auto options = BenchmarkOptions(THREADED_SIZE_MIN, THREADED_SIZE_MAX, THREADED_ALIGN_MIN, THREADED_ALIGN_MAX);
+
+  for (auto x : state) {
+    allocator_benchmark(mm, false, options, alloc_count);
+  }
+
+  state.SetItemsProcessed(isize(alloc_count));
+}
+
+BENCHMARK(BM_AtomicResource_Threads)->ThreadRange(1, THREADED_MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_MagazineResource_Threads)->ThreadRange(1, THREADED_MAX_THREADS)->UseRealTime();
@@ -0,0 +1,139 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+#include <vector>
+#include <wesos-alloc/FreeList.hh>
+#include <wesos-alloc/IntrusivePool.hh>
+#include <wesos-alloc/MonotonicArena.hh>
+
+#include "UnifiedBenchmark.hh"
+
+using namespace wesos;
+using namespace wesos::alloc;
+using namespace wesos::mem;
+using namespace wesos::mem::testing;
+
+static constexpr usize MIXED_SIZE_MIN = 1;
+static constexpr usize MIXED_SIZE_MAX = 1024;
+static constexpr usize MIXED_ALIGN_MIN = 1;
+static constexpr usize MIXED_ALIGN_MAX = 64;
+static constexpr usize PHASE_OBJECTS = 4096;
+static constexpr usize PHASE_POOL_SIZE = 16 * 1024 * 1024;
+
+struct MockData {
+  u64 m_data;
+  MockData *m_prev, *m_next;
+};
+
+static void deps_setup() {
+  wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+    std::cerr << "\n==========================================================================="
+                 "===========\n"
+              << "| Assertion Failed: \"" << message << "\";\n"
+              << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+              << "| File: \"" << source.file_name() << "\";\n"
+              << "============================================================================="
+                 "=========\n"
+              << std::endl;
+  });
+}
+
+/* Allocate a burst of small objects, then drop them all, like a parser building a config tree */
+static void phase_benchmark(MemoryResourceProtocol& mm, std::vector<void*>& objects, usize& alloc_count) {
+  for (usize i = 0; i < PHASE_OBJECTS; i++) {
+    auto ptr = mm.allocate_bytes(sizeof(MockData), alignof(MockData));
+    alloc_count += ptr.isset();
+    objects.push_back(ptr.unwrap());
+  }
+}
+
+static void BM_MonotonicArena_Mixed(benchmark::State& state) {
+  deps_setup();
+
+  usize alloc_count = 0;
+  const auto options = BenchmarkOptions(MIXED_SIZE_MIN, MIXED_SIZE_MAX, MIXED_ALIGN_MIN, MIXED_ALIGN_MAX);
+
+  HostResource upstream;
+  auto mm = MonotonicArena(upstream);
+
+  for (auto x : state) {
+    allocator_benchmark(mm, false, options, alloc_count);
+    mm.reset();
+  }
+
+  state.SetItemsProcessed(isize(alloc_count));
+}
+
+static void BM_MonotonicArena_Phase(benchmark::State& state) {
+  deps_setup();
+
+  usize alloc_count = 0;
+  std::vector<void*> objects;
+  objects.reserve(PHASE_OBJECTS);
+
+  HostResource upstream;
+  auto mm = MonotonicArena(upstream);
+
+  for (auto x : state) {
+    phase_benchmark(mm, objects, alloc_count);
+    mm.reset();
+    objects.clear();
+  }
+
+  state.SetItemsProcessed(isize(alloc_count));
+}
+
+static void BM_IntrusivePool_Phase(benchmark::State& state) {
+  deps_setup();
+
+  usize alloc_count = 0;
+  std::vector<void*> objects;
+  objects.reserve(PHASE_OBJECTS);
+
+  std::vector<MockData> storage(PHASE_OBJECTS);
+  auto mm = IntrusivePool(sizeof(MockData), alignof(MockData),
+                          View<u8>(bit_cast<u8*>(storage.data()), storage.size() * sizeof(MockData)));
+
+  for (auto x : state) {
+    phase_benchmark(mm, objects, alloc_count);
+    for (auto* ptr : objects) {
+      mm.deallocate_bytes(ptr, sizeof(MockData), alignof(MockData));
+    }
+    objects.clear();
+  }
+
+  state.SetItemsProcessed(isize(alloc_count));
+}
+
+static void BM_FreeList_Phase(benchmark::State& state) {
+  deps_setup();
+
+  usize alloc_count = 0;
+  std::vector<void*> objects;
+  objects.reserve(PHASE_OBJECTS);
+
+  std::vector<u8> storage(PHASE_POOL_SIZE);
+  auto mm = FreeList(View<u8>(storage.data(), storage.size()));
+
+  for (auto x : state) {
+    phase_benchmark(mm, objects, alloc_count);
+    for (auto* ptr : objects) {
+      mm.deallocate_bytes(ptr, sizeof(MockData), alignof(MockData));
+    }
+    objects.clear();
+  }
+
+  state.SetItemsProcessed(isize(alloc_count));
+}
+
+BENCHMARK(BM_MonotonicArena_Mixed);
+BENCHMARK(BM_MonotonicArena_Phase);
+BENCHMARK(BM_IntrusivePool_Phase);
+BENCHMARK(BM_FreeList_Phase);
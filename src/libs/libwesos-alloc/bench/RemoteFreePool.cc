@@ -0,0 +1,138 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <wesos-alloc/AtomicIntrusivePool.hh>
+#include <wesos-alloc/IntrusivePool.hh>
+#include <wesos-alloc/RemoteFreePool.hh>
+#include <wesos-mem/AtomicResource.hh>
+
+using namespace wesos;
+using namespace wesos::alloc;
+using namespace wesos::mem;
+
+static constexpr usize PING_PONG_OBJECT_SIZE = 64;
+static constexpr usize PING_PONG_OBJECTS = 256;
+static constexpr usize PING_PONG_RING_SIZE = 64;
+
+static void deps_setup() {
+  wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+    std::cerr << "\n==========================================================================="
+                 "===========\n"
+              << "| Assertion Failed: \"" << message << "\";\n"
+              << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+              << "| File: \"" << source.file_name() << "\";\n"
+              << "============================================================================="
+                 "=========\n"
+              << std::endl;
+  });
+}
+
+namespace {
+  /* Single-producer, single-consumer ring of message pointers */
+  class MessageRing final {
+    std::atomic<void*> m_slots[PING_PONG_RING_SIZE];
+    alignas(64) std::atomic<usize> m_head = 0;
+    alignas(64) std::atomic<usize> m_tail = 0;
+
+  public:
+    auto push(void* message) -> bool {
+      const auto tail = m_tail.load(std::memory_order_relaxed);
+      if (tail - m_head.load(std::memory_order_acquire) == PING_PONG_RING_SIZE) {
+        return false;
+      }
+
+      m_slots[tail % PING_PONG_RING_SIZE].store(message, std::memory_order_relaxed);
+      m_tail.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    auto pop() -> void* {
+      const auto head = m_head.load(std::memory_order_relaxed);
+      if (head == m_tail.load(std::memory_order_acquire)) {
+        return nullptr;
+      }
+
+      auto* message = m_slots[head % PING_PONG_RING_SIZE].load(std::memory_order_relaxed);
+      m_head.store(head + 1, std::memory_order_release);
+      return message;
+    }
+  };
+
+  /* The calling thread allocates messages; a second thread frees them */
+  void ping_pong(benchmark::State& state, MemoryResourceProtocol& mm) {
+    MessageRing ring;
+    std::atomic<bool> done = false;
+
+    std::thread consumer([&] {
+      while (true) {
+        if (auto* message = ring.pop()) {
+          mm.deallocate_bytes(message, PING_PONG_OBJECT_SIZE, 16);
+        } else if (done.load(std::memory_order_acquire)) {
+          break;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    for (auto x : state) {
+      auto ptr = mm.allocate_bytes(PING_PONG_OBJECT_SIZE, 16);
+      while (ptr.is_null()) {
+        std::this_thread::yield();
+        ptr = mm.allocate_bytes(PING_PONG_OBJECT_SIZE, 16);
+      }
+
+      static_cast<u8*>(ptr.unwrap())[0] = 1;
+
+      while (!ring.push(ptr.unwrap())) {
+        std::this_thread::yield();
+      }
+    }
+
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    state.SetItemsProcessed(state.iterations());
+  }
+}  // namespace
+
+static void BM_PingPong_AtomicIntrusivePool(benchmark::State& state) {
+  deps_setup();
+
+  alignas(16) static Array<u8, PING_PONG_OBJECT_SIZE * PING_PONG_OBJECTS> storage;
+  auto mm = AtomicIntrusivePool(PING_PONG_OBJECT_SIZE, 16, storage.as_view());
+
+  ping_pong(state, mm);
+}
+
+static void BM_PingPong_AtomicResource_IntrusivePool(benchmark::State& state) {
+  deps_setup();
+
+  alignas(16) static Array<u8, PING_PONG_OBJECT_SIZE * PING_PONG_OBJECTS> storage;
+  auto pool = IntrusivePool(PING_PONG_OBJECT_SIZE, 16, storage.as_view());
+  auto mm = AtomicResource(pool);
+
+  ping_pong(state, mm);
+}
+
+static void BM_PingPong_RemoteFreePool(benchmark::State& state) {
+  deps_setup();
+
+  alignas(16) static Array<u8, PING_PONG_OBJECT_SIZE * PING_PONG_OBJECTS> storage;
+  auto mm = RemoteFreePool(PING_PONG_OBJECT_SIZE, 16, storage.as_view());
+
+  ping_pong(state, mm);
+}
+
+BENCHMARK(BM_PingPong_AtomicIntrusivePool)->UseRealTime();
+BENCHMARK(BM_PingPong_AtomicResource_IntrusivePool)->UseRealTime();
+BENCHMARK(BM_PingPong_RemoteFreePool)->UseRealTime();
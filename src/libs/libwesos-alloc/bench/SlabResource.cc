@@ -0,0 +1,74 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+#include <vector>
+#include <wesos-alloc/FreeList.hh>
+#include <wesos-alloc/SlabResource.hh>
+
+#include "UnifiedBenchmark.hh"
+
+using namespace wesos;
+using namespace wesos::alloc;
+using namespace wesos::mem;
+using namespace wesos::mem::testing;
+
+static constexpr usize MIXED_SIZE_MIN = 1;
+static constexpr usize MIXED_SIZE_MAX = 1024;
+static constexpr usize MIXED_ALIGN_MIN = 1;
+static constexpr usize MIXED_ALIGN_MAX = 64;
+static constexpr usize FREELIST_POOL_SIZE = 16 * 1024 * 1024;
+
+static void deps_setup() {
+  wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+    std::cerr << "\n==========================================================================="
+                 "===========\n"
+              << "| Assertion Failed: \"" << message << "\";\n"
+              << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+              << "| File: \"" << source.file_name() << "\";\n"
+              << "============================================================================="
+                 "=========\n"
+              << std::endl;
+  });
+}
+
+static void BM_SlabResource_Mixed(benchmark::State& state) {
+  deps_setup();
+
+  usize alloc_count = 0;
+  const auto options = BenchmarkOptions(MIXED_SIZE_MIN, MIXED_SIZE_MAX, MIXED_ALIGN_MIN, MIXED_ALIGN_MAX);
+
+  HostResource backing;
+  auto mm = SlabResource(backing);
+
+  for (auto x : state) {
+    allocator_benchmark(mm, false, options, alloc_count);
+  }
+
+  state.SetItemsProcessed(isize(alloc_count));
+}
+
+static void BM_FreeList_Mixed(benchmark::State& state) {
+  deps_setup();
+
+  usize alloc_count = 0;
+  const auto options = BenchmarkOptions(MIXED_SIZE_MIN, MIXED_SIZE_MAX, MIXED_ALIGN_MIN, MIXED_ALIGN_MAX);
+
+  std::vector<u8> storage(FREELIST_POOL_SIZE);
+  auto mm = FreeList(View<u8>(storage.data(), storage.size()));
+
+  for (auto x : state) {
+    allocator_benchmark(mm, false, options, alloc_count);
+  }
+
+  state.SetItemsProcessed(isize(alloc_count));
+}
+
+BENCHMARK(BM_SlabResource_Mixed);
+BENCHMARK(BM_FreeList_Mixed);
@@ -0,0 +1,124 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <wesos-alloc/MagazineResource.hh>
+#include <wesos-alloc/SlabResource.hh>
+#include <wesos-mem/AtomicResource.hh>
+
+#include "UnifiedBenchmark.hh"
+
+using namespace wesos;
+using namespace wesos::alloc;
+using namespace wesos::mem;
+using namespace wesos::mem::testing;
+
+static constexpr usize TRACE_EVENTS = 1 << 16;
+static constexpr usize TRACE_SIZE_MIN = 8;
+static constexpr usize TRACE_SIZE_MAX = 1024;
+static constexpr usize TRACE_ALIGN_MIN = 8;
+static constexpr usize TRACE_ALIGN_MAX = 64;
+static constexpr int TRACE_MAX_THREADS = 16;
+
+static void deps_setup() {
+  wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+    std::cerr << "\n==========================================================================="
+                 "===========\n"
+              << "| Assertion Failed: \"" << message << "\";\n"
+              << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+              << "| File: \"" << source.file_name() << "\";\n"
+              << "============================================================================="
+                 "=========\n"
+              << std::endl;
+  });
+}
+
+/**
+ * The trace to replay: the synthetic pattern selected by the first argument, or the
+ * `TracingResource` log named by `WESOS_ALLOC_TRACE` if that is set.
+ */
+static auto load_trace(TracePattern pattern) -> AllocationTrace {
+  if (const char* path = std::getenv("WESOS_ALLOC_TRACE")) {
+    if (FILE* stream = std::fopen(path, "r")) {
+      auto trace = AllocationTrace::parse_tracing_log(stream);
+      std::fclose(stream);
+      return trace;
+    }
+  }
+
+  const auto options = BenchmarkOptions(TRACE_SIZE_MIN, TRACE_SIZE_MAX, TRACE_ALIGN_MIN, TRACE_ALIGN_MAX);
+  return AllocationTrace::synthesize(pattern, options, TRACE_EVENTS);
+}
+
+static void replay(benchmark::State& state, MemoryResourceProtocol& mm, HostResource& backing) {
+  deps_setup();
+
+  const auto trace = load_trace(TracePattern(state.range(0)));
+  const auto thread_count = usize(state.range(1));
+
+  ReplayReport total;
+  usize runs = 0;
+
+  for (auto x : state) {
+    const auto report = replay_trace(mm, trace, thread_count, &backing);
+    state.SetIterationTime(report.m_seconds);
+
+    total.m_operations += report.m_operations;
+    total.m_failures += report.m_failures;
+    total.m_seconds += report.m_seconds;
+    total.m_latency_p50_ns += report.m_latency_p50_ns;
+    total.m_latency_p99_ns += report.m_latency_p99_ns;
+    total.m_peak_live_bytes = max(total.m_peak_live_bytes, report.m_peak_live_bytes);
+    total.m_peak_footprint_bytes = max(total.m_peak_footprint_bytes, report.m_peak_footprint_bytes);
+    runs++;
+  }
+
+  state.SetItemsProcessed(isize(total.m_operations));
+  state.counters["failures"] = double(total.m_failures);
+  state.counters["p50_ns"] = double(total.m_latency_p50_ns) / double(max(runs, usize(1)));
+  state.counters["p99_ns"] = double(total.m_latency_p99_ns) / double(max(runs, usize(1)));
+  state.counters["live_KiB"] = double(total.m_peak_live_bytes) / 1024.0;
+  state.counters["footprint_KiB"] = double(total.m_peak_footprint_bytes) / 1024.0;
+}
+
+static void BM_Replay_Host(benchmark::State& state) {
+  HostResource backing;
+  replay(state, backing, backing);
+}
+
+static void BM_Replay_AtomicSlab(benchmark::State& state) {
+  HostResource backing;
+  SlabResource slab(backing);
+  AtomicResource mm(slab);
+  replay(state, mm, backing);
+}
+
+static void BM_Replay_MagazineSlab(benchmark::State& state) {
+  HostResource backing;
+  SlabResource slab(backing);
+  MagazineResource mm(slab);
+  replay(state, mm, backing);
+}
+
+static void trace_arguments(benchmark::internal::Benchmark* b) {
+  for (auto pattern : {TracePattern::Churn, TracePattern::LongLivedChurn, TracePattern::ProducerConsumer,
+                       TracePattern::KernelMix}) {
+    for (int threads = 1; threads <= TRACE_MAX_THREADS; threads *= 2) {
+      b->Args({int(pattern), threads});
+    }
+  }
+
+  b->ArgNames({"pattern", "threads"});
+}
+
+BENCHMARK(BM_Replay_Host)->Apply(trace_arguments)->UseManualTime();
+BENCHMARK(BM_Replay_AtomicSlab)->Apply(trace_arguments)->UseManualTime();
+BENCHMARK(BM_Replay_MagazineSlab)->Apply(trace_arguments)->UseManualTime();
@@ -5,7 +5,12 @@
  * it under the terms of the Unlicense(https://unlicense.org/).
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #define DEFER_INCLUDE
 #include "UnifiedBenchmark.hh"
@@ -25,23 +30,260 @@ namespace wesos::mem::testing {
         return (m_base.*m_method)(args...);
       }
     };
+
+    class Random final {
+      u64 m_state;
+
+    public:
+      constexpr Random(u64 seed) : m_state(seed | 1) {}
+
+      constexpr auto next() -> u64 {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 7;
+        m_state ^= m_state << 17;
+        return m_state;
+      }
+
+      constexpr auto below(u64 bound) -> u64 { return next() % bound; }
+      constexpr auto between(u64 min, u64 max) -> u64 { return min + below(max - min + 1); }
+    };
+
+    struct Block {
+      NullableOwnPtr<void> m_ptr;
+      usize m_size = 0;
+      PowerOfTwo<usize> m_align = PowerOfTwo<usize>(1);
+    };
+
+    struct Mailbox {
+      std::mutex m_lock;
+      std::vector<Block> m_blocks;
+    };
+
+    /* Operations per clock read; large enough that the clock itself is noise */
+    static constexpr usize LATENCY_BATCH = 64;
+
+    /** @brief State of one replaying thread. */
+    struct ReplayThread {
+      std::vector<Block> m_slots;
+      std::vector<Block> m_inbox;
+      Mailbox* m_own_mailbox = nullptr;
+      Mailbox* m_next_mailbox = nullptr;
+      std::vector<u32> m_latencies_ns;
+      std::chrono::steady_clock::time_point m_batch_start;
+      usize m_batch_operations = 0;
+      usize m_operations = 0;
+      usize m_failures = 0;
+      isize m_live_bytes = 0;
+      isize m_peak_live_bytes = 0;
+
+      auto account(isize delta) -> void {
+        m_live_bytes += delta;
+        m_peak_live_bytes = std::max(m_peak_live_bytes, m_live_bytes);
+      }
+
+      /** @brief Records the mean latency of the operations since the last sample. */
+      auto end_batch() -> void {
+        if (m_batch_operations == 0) {
+          return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_batch_start).count();
+
+        m_latencies_ns.push_back(u32(usize(elapsed) / m_batch_operations));
+        m_batch_start = now;
+        m_batch_operations = 0;
+      }
+    };
+
+    template <bool Timed>
+    static auto timed(ReplayThread& thread, const auto& operation) {
+      auto result = operation();
+
+      if constexpr (Timed) {
+        if (++thread.m_batch_operations == LATENCY_BATCH) [[unlikely]] {
+          thread.end_batch();
+        }
+      }
+
+      return result;
+    }
+
+    template <bool Timed>
+    static void release(ReplayThread& thread, const auto& deallocate, Block& block) {
+      if (block.m_ptr.is_null()) {
+        return;
+      }
+
+      timed<Timed>(thread, [&] {
+        deallocate(block.m_ptr, block.m_size, block.m_align);
+        return 0;
+      });
+
+      thread.m_operations++;
+      thread.account(-isize(block.m_size));
+      block.m_ptr = nullptr;
+    }
+
+    template <bool Timed>
+    static auto acquire(ReplayThread& thread, const auto& allocate, const TraceEvent& event) -> Block {
+      const auto align = PowerOfTwo<usize>(event.m_align);
+      const auto ptr = timed<Timed>(thread, [&] { return allocate(event.m_size, align); });
+
+      thread.m_operations++;
+      if (ptr.is_null()) [[unlikely]] {
+        thread.m_failures++;
+        return {};
+      }
+
+      thread.account(isize(event.m_size));
+      return {ptr, event.m_size, align};
+    }
+
+    template <bool Timed>
+    static void replay_events(const auto& allocate, const auto& deallocate, const AllocationTrace& trace,
+                              ReplayThread& thread) {
+      thread.m_slots.resize(trace.slot_count());
+
+      if constexpr (Timed) {
+        thread.m_batch_start = std::chrono::steady_clock::now();
+        thread.m_batch_operations = 0;
+      }
+
+      for (const auto& event : trace.events()) {
+        switch (event.m_kind) {
+          case TraceEvent::Kind::Allocate: {
+            auto& slot = thread.m_slots[event.m_slot];
+            release<Timed>(thread, deallocate, slot);
+            slot = acquire<Timed>(thread, allocate, event);
+            break;
+          }
+
+          case TraceEvent::Kind::Deallocate: {
+            release<Timed>(thread, deallocate, thread.m_slots[event.m_slot]);
+            break;
+          }
+
+          case TraceEvent::Kind::Handoff: {
+            auto block = acquire<Timed>(thread, allocate, event);
+            if (block.m_ptr.isset()) {
+              thread.account(-isize(block.m_size));
+              std::lock_guard lock(thread.m_next_mailbox->m_lock);
+              thread.m_next_mailbox->m_blocks.push_back(block);
+            }
+            break;
+          }
+
+          case TraceEvent::Kind::Drain: {
+            {
+              std::lock_guard lock(thread.m_own_mailbox->m_lock);
+              thread.m_inbox.swap(thread.m_own_mailbox->m_blocks);
+            }
+
+            /* The producer already uncounted these; add them back after release() uncounts them */
+            for (auto& block : thread.m_inbox) {
+              const auto size = isize(block.m_size);
+              release<Timed>(thread, deallocate, block);
+              thread.account(size);
+            }
+
+            thread.m_inbox.clear();
+            break;
+          }
+        }
+      }
+
+      if constexpr (Timed) {
+        thread.end_batch();
+      }
+
+      /* Tear down outside of the measurement */
+      for (auto& slot : thread.m_slots) {
+        release<false>(thread, deallocate, slot);
+      }
+    }
+
+    static void drain_mailbox(const auto& deallocate, Mailbox& mailbox) {
+      for (auto& block : mailbox.m_blocks) {
+        deallocate(block.m_ptr, block.m_size, block.m_align);
+      }
+
+      mailbox.m_blocks.clear();
+    }
+
+    static auto percentile(std::vector<u32>& samples, usize per_mille) -> u64 {
+      if (samples.empty()) {
+        return 0;
+      }
+
+      const auto nth = samples.begin() + isize((samples.size() - 1) * per_mille / 1000);
+      std::nth_element(samples.begin(), nth, samples.end());
+      return *nth;
+    }
+
+    struct KernelSize {
+      usize m_size;
+      usize m_weight;
+    };
+
+    /* Object sizes and their relative frequency in a typical kernel slab workload */
+    static constexpr KernelSize KERNEL_SIZES[] = {
+        {16, 8},   {32, 14},   {64, 22},   {96, 6},    {128, 14},  {192, 9},
+        {256, 10}, {512, 7},   {1024, 5},  {2048, 3},  {4096, 2},
+    };
+
+    static auto kernel_size(Random& random) -> usize {
+      usize total = 0;
+      for (const auto& entry : KERNEL_SIZES) {
+        total += entry.m_weight;
+      }
+
+      auto pick = random.below(total);
+      for (const auto& entry : KERNEL_SIZES) {
+        if (pick < entry.m_weight) {
+          return entry.m_size;
+        }
+        pick -= entry.m_weight;
+      }
+
+      return KERNEL_SIZES[0].m_size;
+    }
+
+    static auto random_align(Random& random, const BenchmarkOptions& options) -> usize {
+      usize align = options.m_align_min;
+      while (align < options.m_align_max && random.below(2) != 0) {
+        align *= 2;
+      }
+
+      return align;
+    }
   }  // namespace detail
 
   static void benchmark_crunch(const auto& allocate, const auto& deallocate, const BenchmarkOptions& options,
                                usize& alloc_count) {
-    // FIXME: Implement realistic allocation patterns
+    thread_local AllocationTrace trace;
+    thread_local detail::ReplayThread thread;
+    thread_local Nullable<BenchmarkOptions> traced_options;
 
-    const auto [min_size, max_size, min_align, max_align] = options;
+    const auto same_options = [&] {
+      const auto& prev = traced_options.value_unchecked();
+      return prev.m_size_min == options.m_size_min && prev.m_size_max == options.m_size_max &&
+             prev.m_align_min == options.m_align_min && prev.m_align_max == options.m_align_max;
+    };
 
-    for (usize size = min_size; size <= max_size; size++) {
-      for (auto align = min_align; align <= max_align; align = align.next()) {
-        auto ptr = allocate(size, align);
-        alloc_count += ptr.isset();
-        deallocate(ptr, size, align);
-      }
+    if (traced_options.is_null() || !same_options()) {
+      trace = AllocationTrace::synthesize(TracePattern::Sweep, options, 0);
+      traced_options = options;
     }
-  }
 
+    const auto failures = thread.m_failures;
+    const auto operations = thread.m_operations;
+
+    detail::replay_events<false>(allocate, deallocate, trace, thread);
+
+    /* Every successful allocation in a sweep is paired with a free */
+    alloc_count += ((thread.m_operations - operations) - (thread.m_failures - failures)) / 2;
+  }
 }  // namespace wesos::mem::testing
 
 static std::mutex simulate_global_lock;
@@ -73,3 +315,233 @@ void wesos::mem::testing::allocator_benchmark(MemoryResourceProtocol& mm, bool s
     benchmark_crunch(allocate_nosync, deallocate_nosync, options, alloc_count);
   }
 }
+
+auto wesos::mem::testing::AllocationTrace::push_allocate(u32 slot, usize size, usize align) -> void {
+  m_events.push_back({TraceEvent::Kind::Allocate, slot, size, align});
+  m_slot_count = std::max(m_slot_count, slot + 1);
+}
+
+auto wesos::mem::testing::AllocationTrace::push_deallocate(u32 slot) -> void {
+  m_events.push_back({TraceEvent::Kind::Deallocate, slot, 0, 1});
+  m_slot_count = std::max(m_slot_count, slot + 1);
+}
+
+auto wesos::mem::testing::AllocationTrace::push_handoff(usize size, usize align) -> void {
+  m_events.push_back({TraceEvent::Kind::Handoff, 0, size, align});
+}
+
+auto wesos::mem::testing::AllocationTrace::push_drain() -> void {
+  m_events.push_back({TraceEvent::Kind::Drain, 0, 0, 1});
+}
+
+auto wesos::mem::testing::AllocationTrace::synthesize(TracePattern pattern, BenchmarkOptions options,
+                                                      usize event_count, u64 seed) -> AllocationTrace {
+  static constexpr u32 CHURN_WINDOW = 256;
+  static constexpr u32 LONG_LIVED_COUNT = 1024;
+  static constexpr usize HANDOFF_BATCH = 64;
+  static constexpr u32 KERNEL_SHORT_WINDOW = 32;
+  static constexpr u32 KERNEL_LONG_WINDOW = 2048;
+
+  AllocationTrace trace;
+  detail::Random random(seed);
+
+  const auto random_size = [&] { return usize(random.between(options.m_size_min, options.m_size_max)); };
+  const auto churn = [&](u32 first_slot, u32 window, usize events) {
+    for (u32 i = 0; i < window; i++) {
+      trace.push_allocate(first_slot + i, random_size(), detail::random_align(random, options));
+    }
+
+    /* Reallocating a slot frees its previous block first, so each event is a free and an allocate */
+    for (usize i = window * 2; i < events; i += 2) {
+      const auto slot = first_slot + u32(random.below(window));
+      trace.push_allocate(slot, random_size(), detail::random_align(random, options));
+    }
+  };
+
+  switch (pattern) {
+    case TracePattern::Sweep: {
+      for (usize size = options.m_size_min; size <= options.m_size_max; size++) {
+        for (auto align = options.m_align_min; align <= options.m_align_max; align = align.next()) {
+          trace.push_allocate(0, size, align);
+          trace.push_deallocate(0);
+        }
+      }
+      break;
+    }
+
+    case TracePattern::Churn: {
+      churn(0, CHURN_WINDOW, event_count);
+      break;
+    }
+
+    case TracePattern::LongLivedChurn: {
+      for (u32 i = 0; i < LONG_LIVED_COUNT; i++) {
+        trace.push_allocate(CHURN_WINDOW + i, random_size(), detail::random_align(random, options));
+      }
+
+      churn(0, CHURN_WINDOW, event_count > LONG_LIVED_COUNT ? event_count - LONG_LIVED_COUNT : 0);
+      break;
+    }
+
+    case TracePattern::ProducerConsumer: {
+      /* Each batch is HANDOFF_BATCH allocations here and as many frees on the consumer */
+      for (usize i = 0; i < event_count; i += HANDOFF_BATCH * 2) {
+        for (usize j = 0; j < HANDOFF_BATCH; j++) {
+          trace.push_handoff(random_size(), detail::random_align(random, options));
+        }
+
+        trace.push_drain();
+      }
+      break;
+    }
+
+    case TracePattern::KernelMix: {
+      /* Most objects die young; one in eight outlives thousands of its peers */
+      for (usize i = 0; i < event_count; i += 2) {
+        const auto long_lived = random.below(8) == 0;
+        const auto slot = long_lived ? KERNEL_SHORT_WINDOW + u32(random.below(KERNEL_LONG_WINDOW))
+                                     : u32(random.below(KERNEL_SHORT_WINDOW));
+        const auto size = detail::kernel_size(random);
+
+        trace.push_allocate(slot, size, std::max(usize(options.m_align_min), size >= 64 ? usize(64) : usize(8)));
+      }
+      break;
+    }
+  }
+
+  return trace;
+}
+
+auto wesos::mem::testing::AllocationTrace::parse_tracing_log(FILE* stream) -> AllocationTrace {
+  AllocationTrace trace;
+  std::unordered_map<void*, u32> slot_of;
+  std::vector<u32> free_slots;
+  u32 next_slot = 0;
+
+  char line[256];
+  while (fgets(line, sizeof(line), stream) != nullptr) {
+    usize size = 0;
+    usize align = 0;
+    void* ptr = nullptr;
+
+    if (sscanf(line, "TracingResource::allocate_bytes(%zu, %zu) -> %p", &size, &align, &ptr) == 3) {
+      if (ptr == nullptr) {
+        continue;
+      }
+
+      u32 slot = next_slot;
+      if (free_slots.empty()) {
+        next_slot++;
+      } else {
+        slot = free_slots.back();
+        free_slots.pop_back();
+      }
+
+      slot_of[ptr] = slot;
+      trace.push_allocate(slot, size, align);
+    } else if (sscanf(line, "TracingResource::deallocate_bytes(%p, %zu, %zu)", &ptr, &size, &align) == 3) {
+      const auto it = slot_of.find(ptr);
+      if (it == slot_of.end()) {
+        continue;
+      }
+
+      trace.push_deallocate(it->second);
+      free_slots.push_back(it->second);
+      slot_of.erase(it);
+    }
+  }
+
+  return trace;
+}
+
+auto wesos::mem::testing::replay_trace(MemoryResourceProtocol& mm, const AllocationTrace& trace, usize thread_count,
+                                       HostResource* backing) -> ReplayReport {
+  const auto allocate = [&](usize size, PowerOfTwo<usize> align) { return mm.allocate_bytes(size, align); };
+  const auto deallocate = [&](NullableOwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) {
+    mm.deallocate_bytes(ptr, size, align);
+  };
+
+  thread_count = std::max(thread_count, usize(1));
+
+  std::vector<detail::ReplayThread> threads(thread_count);
+  std::vector<detail::Mailbox> mailboxes(thread_count);
+  std::vector<std::thread> workers;
+  std::atomic<usize> ready = 0;
+  std::atomic<bool> go = false;
+
+  for (usize i = 0; i < thread_count; i++) {
+    threads[i].m_own_mailbox = &mailboxes[i];
+    threads[i].m_next_mailbox = &mailboxes[(i + 1) % thread_count];
+    threads[i].m_latencies_ns.reserve((trace.events().size() * 2 / detail::LATENCY_BATCH) + 1);
+  }
+
+  if (backing != nullptr) {
+    backing->reset_peak();
+  }
+
+  for (usize i = 0; i < thread_count; i++) {
+    workers.emplace_back([&, i] {
+      ready.fetch_add(1);
+      while (!go.load()) {
+        std::this_thread::yield();
+      }
+
+      detail::replay_events<true>(allocate, deallocate, trace, threads[i]);
+    });
+  }
+
+  while (ready.load() != thread_count) {
+    std::this_thread::yield();
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  go.store(true);
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  ReplayReport report;
+  report.m_seconds = std::chrono::duration<double>(elapsed).count();
+  report.m_peak_footprint_bytes = backing != nullptr ? backing->peak_bytes() : 0;
+
+  std::vector<u32> latencies;
+  for (auto& thread : threads) {
+    report.m_operations += thread.m_operations;
+    report.m_failures += thread.m_failures;
+    report.m_peak_live_bytes += usize(thread.m_peak_live_bytes);
+    latencies.insert(latencies.end(), thread.m_latencies_ns.begin(), thread.m_latencies_ns.end());
+  }
+
+  for (auto& mailbox : mailboxes) {
+    detail::drain_mailbox(deallocate, mailbox);
+  }
+
+  report.m_latency_p50_ns = detail::percentile(latencies, 500);
+  report.m_latency_p99_ns = detail::percentile(latencies, 990);
+
+  return report;
+}
+
+auto wesos::mem::testing::HostResource::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  const auto bytes = (size + align - 1) & ~(align - 1);
+  auto* ptr = std::aligned_alloc(align, bytes);
+  if (ptr == nullptr) [[unlikely]] {
+    return null;
+  }
+
+  const auto live = m_live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  auto peak = m_peak_bytes.load(std::memory_order_relaxed);
+  while (live > peak && !m_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+
+  return ptr;
+}
+
+auto wesos::mem::testing::HostResource::virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align)
+    -> void {
+  m_live_bytes.fetch_sub((size + align - 1) & ~(align - 1), std::memory_order_relaxed);
+  std::free(ptr.unwrap());
+}
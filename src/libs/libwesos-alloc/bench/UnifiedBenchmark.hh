@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdio>
+#include <vector>
 #include <wesos-mem/MemoryResourceProtocol.hh>
 
 namespace wesos::mem::testing {
@@ -18,5 +21,108 @@ namespace wesos::mem::testing {
         : m_size_min(size_min), m_size_max(size_max), m_align_min(align_min), m_align_max(align_max) {}
   };
 
+  /**
+   * @brief Replays the sweep trace of `options` (every size and alignment pair,
+   * freed immediately) against `mm`.
+   */
   void allocator_benchmark(MemoryResourceProtocol& mm, bool sync, BenchmarkOptions options, usize& alloc_count);
+
+  struct TraceEvent {
+    enum class Kind : u8 {
+      Allocate,   /* Allocate into slot `m_slot` */
+      Deallocate, /* Free whatever slot `m_slot` holds */
+      Handoff,    /* Allocate and pass the block to the next thread */
+      Drain,      /* Free every block handed to this thread so far */
+    };
+
+    Kind m_kind;
+    u32 m_slot;
+    usize m_size;
+    usize m_align;
+  };
+
+  enum class TracePattern : u8 {
+    Sweep,            /* Every size and alignment pair, freed immediately */
+    Churn,            /* A fixed window of live blocks, replaced at random */
+    LongLivedChurn,   /* Churn on top of a population that lives for the whole trace */
+    ProducerConsumer, /* Blocks are allocated on one thread and freed on another */
+    KernelMix,        /* Size and lifetime distribution of a kernel object workload */
+  };
+
+  /** @brief A sequence of allocation events that can be replayed on any number of threads. */
+  class AllocationTrace final {
+    std::vector<TraceEvent> m_events;
+    u32 m_slot_count = 0;
+
+  public:
+    AllocationTrace() = default;
+
+    /**
+     * @brief Generates a deterministic synthetic trace.
+     * @param event_count Approximate number of events; ignored by `Sweep`.
+     */
+    [[nodiscard]] static auto synthesize(TracePattern pattern, BenchmarkOptions options, usize event_count,
+                                         u64 seed = 0x9e3779b97f4a7c15) -> AllocationTrace;
+
+    /**
+     * @brief Reads a trace recorded by `TracingResource`.
+     * @note Deallocations of pointers not allocated within the recording are dropped.
+     */
+    [[nodiscard]] static auto parse_tracing_log(FILE* stream) -> AllocationTrace;
+
+    auto push_allocate(u32 slot, usize size, usize align) -> void;
+    auto push_deallocate(u32 slot) -> void;
+    auto push_handoff(usize size, usize align) -> void;
+    auto push_drain() -> void;
+
+    [[nodiscard]] auto events() const -> const std::vector<TraceEvent>& { return m_events; }
+    [[nodiscard]] auto slot_count() const -> u32 { return m_slot_count; }
+  };
+
+  struct ReplayReport {
+    usize m_operations = 0;
+    usize m_failures = 0;
+    double m_seconds = 0;
+    u64 m_latency_p50_ns = 0;
+    u64 m_latency_p99_ns = 0;
+    usize m_peak_live_bytes = 0;
+    usize m_peak_footprint_bytes = 0;
+
+    [[nodiscard]] auto throughput() const -> double { return m_seconds > 0 ? double(m_operations) / m_seconds : 0; }
+  };
+
+  class HostResource;
+
+  /**
+   * @brief Replays `trace` on `thread_count` threads at once, each with its own slots.
+   *
+   * Operations are timed in batches of 64, so the clock adds nothing measurable to
+   * the throughput; the latency percentiles are over those batch means. Blocks still
+   * live when a thread reaches the end of the trace are freed outside of the measurement.
+   *
+   * @param backing If given, its peak footprint over the run is reported.
+   */
+  [[nodiscard]] auto replay_trace(MemoryResourceProtocol& mm, const AllocationTrace& trace, usize thread_count,
+                                  HostResource* backing = nullptr) -> ReplayReport;
+
+  /** @brief Backing resource that forwards to the host C library and tracks its footprint. */
+  class HostResource final : public MemoryResourceProtocol {
+    std::atomic<usize> m_live_bytes = 0;
+    std::atomic<usize> m_peak_bytes = 0;
+
+    auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
+    auto virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void override;
+
+  public:
+    HostResource() = default;
+    HostResource(const HostResource&) = delete;
+    HostResource(HostResource&&) = delete;
+    auto operator=(const HostResource&) -> HostResource& = delete;
+    auto operator=(HostResource&&) -> HostResource& = delete;
+    ~HostResource() override = default;
+
+    [[nodiscard]] auto live_bytes() const -> usize { return m_live_bytes.load(std::memory_order_relaxed); }
+    [[nodiscard]] auto peak_bytes() const -> usize { return m_peak_bytes.load(std::memory_order_relaxed); }
+    auto reset_peak() -> void { m_peak_bytes.store(live_bytes(), std::memory_order_relaxed); }
+  };
 }  // namespace wesos::mem::testing
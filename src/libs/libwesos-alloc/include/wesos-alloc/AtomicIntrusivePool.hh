@@ -0,0 +1,90 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-cpu/Target.hh>
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-sync/Atomic.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::alloc {
+  /**
+   * @brief Lock-free variant of `IntrusivePool`.
+   *
+   * The free list is a Treiber stack. Its head packs the node pointer together
+   * with a generation tag that is bumped on every update, so a pop racing with a
+   * pop/push of the same node (ABA) fails its compare-exchange instead of
+   * corrupting the list. On x86_64 the tag lives in the 16 non-canonical address
+   * bits; on i386 the head is a 64-bit word.
+   *
+   * @note Popping reads the link of a node another thread may have just taken, so
+   * the first `minimum_size()` bytes of every object may be read after it is
+   * handed out. The memory itself must outlive the pool.
+   */
+  class AtomicIntrusivePool final : public mem::MemoryResourceProtocol {
+    template <class>
+    friend class mem::StaticResource;
+
+    struct FreeNode {
+      sync::Atomic<FreeNode*> m_next;
+    };
+
+  public:
+    using ObjectSize = ClampLeast<usize, sizeof(FreeNode)>;
+
+  private:
+#if ARCH_X86_64
+    static constexpr u64 TAG_SHIFT = 48;
+#elif ARCH_X86_32
+    static constexpr u64 TAG_SHIFT = 32;
+#endif
+
+    sync::Atomic<u64> m_front;
+    ObjectSize m_object_size;
+    PowerOfTwo<usize> m_object_align;
+
+    [[nodiscard]] constexpr auto object_size() const { return m_object_size.unwrap(); }
+    [[nodiscard]] constexpr auto object_align() const { return m_object_align.unwrap(); }
+
+    [[nodiscard]] static auto pack(FreeNode* node, u64 tag) -> u64 {
+      return (static_cast<u64>(bit_cast<uptr>(node)) & ((u64(1) << TAG_SHIFT) - 1)) | (tag << TAG_SHIFT);
+    }
+
+    [[nodiscard]] static auto unpack_tag(u64 word) -> u64 { return word >> TAG_SHIFT; }
+
+    [[nodiscard]] static auto unpack_node(u64 word) -> FreeNode* {
+      /* Sign-extend the address so higher-half pointers survive the round trip */
+      constexpr auto tag_bits = (sizeof(u64) * 8) - TAG_SHIFT;
+      return bit_cast<FreeNode*>(static_cast<uptr>(static_cast<i64>(word << tag_bits) >> tag_bits));
+    }
+
+    auto push_chain(RefPtr<FreeNode> first, RefPtr<FreeNode> last) -> void;
+    [[nodiscard]] auto pop() -> NullableRefPtr<FreeNode>;
+    [[nodiscard]] auto pop_chain(View<void*> out) -> usize;
+
+    [[nodiscard]] auto virt_embezzle(usize max_size) -> View<u8> override;
+    [[nodiscard]] auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
+    auto virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void override;
+    [[nodiscard]] auto virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize override;
+    auto virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void override;
+    auto virt_utilize(View<u8> pool) -> void override;
+    [[nodiscard]] auto virt_accepts_donations() const -> bool override;
+
+  public:
+    AtomicIntrusivePool(ObjectSize object_size, PowerOfTwo<usize> object_align,
+                        View<u8> pool = View<u8>::create_empty());
+    AtomicIntrusivePool(const AtomicIntrusivePool&) = delete;
+    AtomicIntrusivePool(AtomicIntrusivePool&&) = delete;
+    auto operator=(const AtomicIntrusivePool&) -> AtomicIntrusivePool& = delete;
+    auto operator=(AtomicIntrusivePool&&) -> AtomicIntrusivePool& = delete;
+    ~AtomicIntrusivePool() override;
+
+    [[nodiscard]] static constexpr auto minimum_size() { return sizeof(FreeNode); }
+    [[nodiscard]] static constexpr auto minimum_alignment() { return alignof(FreeNode); }
+  };
+}  // namespace wesos::alloc
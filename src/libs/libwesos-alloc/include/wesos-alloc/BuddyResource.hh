@@ -0,0 +1,112 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::alloc {
+  /**
+   * @brief Binary buddy allocator for page-granular memory.
+   *
+   * Blocks are `PAGE_SIZE << order` bytes for orders `0..MAX_ORDER` and are
+   * naturally aligned to their size in absolute address space, so a request for
+   * N aligned pages is served by a single block. Splitting and merging are
+   * O(MAX_ORDER). Each pool passed to `utilize_bytes` becomes a region that keeps
+   * its descriptor and one state byte per page in its own first pages. Region
+   * lookups move the region they find to the front of the list, so the free path
+   * stays O(1) while allocations come from the same few regions.
+   *
+   * @note This resource is not thread-safe. Wrap it in an `AtomicResource` if needed.
+   */
+  class BuddyResource final : public mem::MemoryResourceProtocol {
+    template <class>
+    friend class mem::StaticResource;
+
+  public:
+    static constexpr usize PAGE_SIZE = 4096;
+    static constexpr usize MAX_ORDER = 18;
+    static constexpr usize ORDER_COUNT = MAX_ORDER + 1;
+    static constexpr usize MAX_BLOCK_SIZE = PAGE_SIZE << MAX_ORDER;
+
+  private:
+    struct FreeBlock {
+      NullableRefPtr<FreeBlock> m_prev;
+      NullableRefPtr<FreeBlock> m_next;
+    };
+
+    struct Region {
+      NullableRefPtr<Region> m_next;
+      uptr m_first_pfn;
+      usize m_page_count;
+
+      /* One byte per page follows the descriptor */
+      [[nodiscard]] auto page_state(uptr pfn) -> u8&;
+      [[nodiscard]] constexpr auto contains_pfn(uptr pfn) const -> bool {
+        return pfn >= m_first_pfn && pfn - m_first_pfn < m_page_count;
+      }
+    };
+
+    /* A page's state is zero, or one of these flags plus the order of the block it heads */
+    static constexpr u8 PAGE_FREE = 0x80;
+    static constexpr u8 PAGE_ALLOCATED = 0x40;
+
+    NullableRefPtr<Region> m_regions;
+    Array<NullableRefPtr<FreeBlock>, ORDER_COUNT> m_free;
+    usize m_free_bytes = 0;
+
+    [[nodiscard]] static auto pfn_of(const void* ptr) -> uptr { return bit_cast<uptr>(ptr) / PAGE_SIZE; }
+    [[nodiscard]] static auto block_of(uptr pfn) -> RefPtr<FreeBlock> {
+      return bit_cast<FreeBlock*>(pfn * PAGE_SIZE);
+    }
+
+    [[nodiscard]] auto region_of(uptr pfn) -> NullableRefPtr<Region>;
+    auto push_free(Region& region, uptr pfn, usize order) -> void;
+    auto remove_free(Region& region, uptr pfn, usize order) -> void;
+
+    [[nodiscard]] auto virt_embezzle(usize max_size) -> View<u8> override;
+    [[nodiscard]] auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
+    auto virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void override;
+    auto virt_utilize(View<u8> pool) -> void override;
+    [[nodiscard]] auto virt_accepts_donations() const -> bool override;
+
+  public:
+    BuddyResource(View<u8> pool = View<u8>::create_empty());
+    BuddyResource(const BuddyResource&) = delete;
+    BuddyResource(BuddyResource&&) = delete;
+    auto operator=(const BuddyResource&) -> BuddyResource& = delete;
+    auto operator=(BuddyResource&&) -> BuddyResource& = delete;
+    ~BuddyResource() override = default;
+
+    /**
+     * @brief Smallest order whose block satisfies both the size and the alignment.
+     * @return The order, or null if the request exceeds `MAX_BLOCK_SIZE`.
+     */
+    [[nodiscard]] static constexpr auto order_of(usize size, PowerOfTwo<usize> align) -> Nullable<usize> {
+      const auto bytes = max(max(size, align.unwrap()), PAGE_SIZE);
+      if (bytes > MAX_BLOCK_SIZE) [[unlikely]] {
+        return null;
+      }
+
+      usize order = 0;
+      while ((PAGE_SIZE << order) < bytes) {
+        ++order;
+      }
+
+      return order;
+    }
+
+    /**
+     * @brief Checks whether `ptr` is a block this resource allocated and has not freed yet.
+     * @note Pages that were embezzled, or that are still free, are not owned even
+     * though they lie inside a managed region.
+     */
+    [[nodiscard]] auto owns(const void* ptr) -> bool;
+    [[nodiscard]] constexpr auto free_bytes() const -> usize { return m_free_bytes; }
+  };
+}  // namespace wesos::alloc
@@ -11,29 +11,87 @@
 #include <wesos-types/Types.hh>
 
 namespace wesos::alloc {
+  /**
+   * @brief General-purpose segregated-fit allocator.
+   *
+   * Free blocks are kept in two-level segregated lists (a power-of-two range
+   * split into `SL_COUNT` linear steps) with bitmaps over both levels, so finding
+   * a fitting block and inserting or removing one are O(1). Every block carries a
+   * header and a footer boundary tag, making coalescing with both neighbors O(1).
+   * Payloads are `GRANULE` aligned; larger alignments split off a leading block.
+   *
+   * @note This resource is not thread-safe. Wrap it in an `AtomicResource` if needed.
+   */
   class FreeList final : public mem::MemoryResourceProtocol {
-    struct Chunk {
-      static constexpr usize CHUNK_SIZE = sizeof(void*) * 2;
+    template <class>
+    friend class mem::StaticResource;
+
+    using Tag = usize;
 
-      usize m_size = 0;
+    struct Chunk {
+      NullableRefPtr<Chunk> m_prev;
       NullableRefPtr<Chunk> m_next;
     };
 
-    static_assert(sizeof(Chunk) == Chunk::CHUNK_SIZE, "Chunk size mismatch");
+    static constexpr usize TAG_SIZE = sizeof(Tag);
+    static constexpr usize GRANULE = TAG_SIZE * 2;
+    static constexpr usize MIN_BLOCK_SIZE = TAG_SIZE + sizeof(Chunk) + TAG_SIZE;
+    static constexpr Tag TAG_FREE = 1;
+
+    static constexpr usize SL_SHIFT = 4;
+    static constexpr usize SL_COUNT = usize(1) << SL_SHIFT;
+    static constexpr usize FL_SHIFT = SL_SHIFT + (GRANULE == 16 ? 4 : 3);
+    static constexpr usize SMALL_BLOCK_SIZE = usize(1) << FL_SHIFT;
+    static constexpr usize MAX_BLOCK_SHIFT = sizeof(usize) == 8 ? 40 : 31;
+    static constexpr usize FL_COUNT = MAX_BLOCK_SHIFT - FL_SHIFT + 1;
 
-    NullableRefPtr<Chunk> m_front;
+    static_assert(SMALL_BLOCK_SIZE / SL_COUNT == GRANULE, "Small bins must be one granule apart");
+    static_assert(FL_COUNT <= sizeof(u64) * 8, "First-level bitmap is too narrow");
 
+    struct Bin {
+      usize m_fl;
+      usize m_sl;
+    };
+
+  public:
     struct Statistics {
       usize m_total_memory_managed_bytes = 0;
       usize m_total_memory_allocated_bytes = 0;
       usize m_accumulated_allocations_bytes = 0;
       usize m_accumulated_deallocations_bytes = 0;
-    } m_statistics;
+    };
+
+    static constexpr usize MAX_BLOCK_SIZE = usize(1) << MAX_BLOCK_SHIFT;
+
+  private:
+    u64 m_fl_bitmap = 0;
+    Array<u32, FL_COUNT> m_sl_bitmap;
+    Array<Array<NullableRefPtr<Chunk>, SL_COUNT>, FL_COUNT> m_bins;
+    Statistics m_statistics;
+
+    [[nodiscard]] static auto tag_at(uptr addr) -> Tag& { return *bit_cast<Tag*>(addr); }
+    [[nodiscard]] static auto block_of(RefPtr<Chunk> chunk) -> uptr {
+      return bit_cast<uptr>(chunk.unwrap()) - TAG_SIZE;
+    }
+    [[nodiscard]] static auto chunk_of(uptr block) -> RefPtr<Chunk> { return bit_cast<Chunk*>(block + TAG_SIZE); }
+    static auto write_tags(uptr block, usize block_size, Tag flags) -> void {
+      tag_at(block) = block_size | flags;
+      tag_at(block + block_size - TAG_SIZE) = block_size | flags;
+    }
+
+    [[nodiscard]] static auto mapping_insert(usize block_size) -> Bin;
+    [[nodiscard]] static auto mapping_search(usize block_size) -> Nullable<Bin>;
+
+    [[nodiscard]] auto find_free(usize block_size) -> NullableRefPtr<Chunk>;
+    auto insert_free(RefPtr<Chunk> chunk, usize block_size) -> void;
+    auto remove_free(RefPtr<Chunk> chunk, usize block_size) -> void;
+    [[nodiscard]] auto take_block(RefPtr<Chunk> chunk, usize block_size, usize leading, usize needed) -> RefPtr<u8>;
 
     [[nodiscard]] auto virt_embezzle(usize max_size) -> View<u8> override;
     [[nodiscard]] auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
     auto virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void override;
     auto virt_utilize(View<u8> pool) -> void override;
+    [[nodiscard]] auto virt_accepts_donations() const -> bool override;
 
   public:
     FreeList(View<u8> pool = View<u8>::create_empty());
@@ -42,5 +100,7 @@ namespace wesos::alloc {
     auto operator=(const FreeList&) -> FreeList& = delete;
     auto operator=(FreeList&&) -> FreeList& = delete;
     ~FreeList() override;
+
+    [[nodiscard]] constexpr auto statistics() const -> const Statistics& { return m_statistics; }
   };
 }  // namespace wesos::alloc
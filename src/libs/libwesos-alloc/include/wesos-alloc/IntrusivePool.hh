@@ -11,7 +11,18 @@
 #include <wesos-types/Types.hh>
 
 namespace wesos::alloc {
+  /**
+   * @brief Fixed-size object pool backed by an intrusive free list.
+   *
+   * Pools handed to `utilize_bytes` are not split up front. The largest one
+   * becomes a bump frontier that objects are carved from on first use, so
+   * creating a pool over a large region is O(1) and touches no object memory.
+   * Freed objects go to the free list, which is always preferred.
+   */
   class IntrusivePool final : public mem::MemoryResourceProtocol {
+    template <class>
+    friend class mem::StaticResource;
+
     struct FreeNode {
       NullableRefPtr<FreeNode> m_next;
     };
@@ -21,16 +32,22 @@ namespace wesos::alloc {
 
   private:
     NullableRefPtr<FreeNode> m_front;
+    View<u8> m_frontier;
     ObjectSize m_object_size;
     PowerOfTwo<usize> m_object_align;
 
     [[nodiscard]] constexpr auto object_size() const { return m_object_size.unwrap(); }
     [[nodiscard]] constexpr auto object_align() const { return m_object_align.unwrap(); }
 
+    [[nodiscard]] auto carve() -> NullableOwnPtr<u8>;
+
     [[nodiscard]] auto virt_embezzle(usize max_size) -> View<u8> override;
     [[nodiscard]] auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
     auto virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void override;
+    [[nodiscard]] auto virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize override;
+    auto virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void override;
     auto virt_utilize(View<u8> pool) -> void override;
+    [[nodiscard]] auto virt_accepts_donations() const -> bool override;
 
   public:
     IntrusivePool(ObjectSize object_size, PowerOfTwo<usize> object_align, View<u8> pool = View<u8>::create_empty());
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-alloc/SizeClass.hh>
+#include <wesos-cpu/PerCpu.hh>
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-sync/SpinLock.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::alloc {
+  /**
+   * @brief Thread-safe per-CPU object cache in front of a single-threaded resource.
+   *
+   * Each CPU keeps two magazines (fixed-size stacks of free blocks) per size class
+   * and serves allocations and deallocations from them under a CPU-local lock.
+   * The shared depot lock, which also guards the inner resource, is only taken to
+   * exchange a full or empty magazine, to refill a magazine in bulk, or for
+   * requests larger than `SizeClass::MAX_SIZE`.
+   *
+   * @note The inner resource does not have to be thread-safe. Everything cached is
+   * returned to it on destruction.
+   */
+  class MagazineResource final : public mem::MemoryResourceProtocol {
+    template <class>
+    friend class mem::StaticResource;
+
+  public:
+    static constexpr usize MAGAZINE_ROUNDS = 30;
+
+  private:
+    struct Magazine {
+      NullableRefPtr<Magazine> m_next;
+      usize m_rounds = 0;
+      Array<NullableOwnPtr<void>, MAGAZINE_ROUNDS> m_round;
+
+      [[nodiscard]] constexpr auto is_empty() const -> bool { return m_rounds == 0; }
+      [[nodiscard]] constexpr auto is_full() const -> bool { return m_rounds == MAGAZINE_ROUNDS; }
+    };
+
+    struct CpuCache {
+      sync::SpinLock m_lock;
+      Array<NullableRefPtr<Magazine>, SizeClass::COUNT> m_loaded;
+      Array<NullableRefPtr<Magazine>, SizeClass::COUNT> m_previous;
+    };
+
+    struct Depot {
+      NullableRefPtr<Magazine> m_full;
+      NullableRefPtr<Magazine> m_empty;
+    };
+
+    mem::MemoryResourceProtocol& m_inner;
+    sync::SpinLock m_depot_lock;
+    Array<Depot, SizeClass::COUNT> m_depots;
+    cpu::PerCpu<CpuCache> m_caches;
+
+    [[nodiscard]] auto new_magazine() -> NullableRefPtr<Magazine>;
+    auto drain_magazine(RefPtr<Magazine> magazine, usize index) -> void;
+    auto drain_depot() -> void;
+    [[nodiscard]] auto exchange_full(CpuCache& cache, usize index) -> bool;
+    [[nodiscard]] auto exchange_empty(CpuCache& cache, usize index) -> bool;
+
+    [[nodiscard]] auto virt_embezzle(usize max_size) -> View<u8> override;
+    [[nodiscard]] auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
+    auto virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void override;
+    [[nodiscard]] auto virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize override;
+    auto virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void override;
+    auto virt_utilize(View<u8> pool) -> void override;
+
+  public:
+    MagazineResource(mem::MemoryResourceProtocol& inner);
+    MagazineResource(const MagazineResource&) = delete;
+    MagazineResource(MagazineResource&&) = delete;
+    auto operator=(const MagazineResource&) -> MagazineResource& = delete;
+    auto operator=(MagazineResource&&) -> MagazineResource& = delete;
+    ~MagazineResource() override;
+  };
+}  // namespace wesos::alloc
@@ -0,0 +1,65 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::alloc {
+  /**
+   * @brief Bump allocator for short-lived, allocation-heavy phases.
+   *
+   * Memory is carved from chunks taken from the upstream resource; each new chunk
+   * is twice the size of the previous one, up to `MAX_CHUNK_SIZE`. Deallocation is
+   * a no-op and `reset()` returns every chunk upstream in O(chunks).
+   *
+   * Every byte the arena holds belongs to an upstream chunk, so it neither embezzles
+   * nor accepts donated pools; `utilize_bytes` is ignored.
+   *
+   * @note This resource is not thread-safe. Wrap it in an `AtomicResource` if needed.
+   */
+  class MonotonicArena final : public mem::MemoryResourceProtocol {
+    template <class>
+    friend class mem::StaticResource;
+
+    struct Chunk {
+      NullableRefPtr<Chunk> m_next;
+      usize m_size;
+
+      constexpr Chunk(NullableRefPtr<Chunk> next, usize size) : m_next(next), m_size(size) {}
+    };
+
+    mem::MemoryResourceProtocol& m_upstream;
+    NullableRefPtr<Chunk> m_chunks;
+    uptr m_cursor = 0;
+    uptr m_end = 0;
+    usize m_initial_chunk_size;
+    usize m_next_chunk_size;
+
+    [[nodiscard]] auto grow(usize size, PowerOfTwo<usize> align) -> bool;
+
+    [[nodiscard]] auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
+    auto virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void override;
+    [[nodiscard]] auto virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize override;
+    auto virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void override;
+
+  public:
+    static constexpr usize DEFAULT_CHUNK_SIZE = 4096;
+    static constexpr usize MAX_CHUNK_SIZE = 1024 * 1024;
+
+    MonotonicArena(mem::MemoryResourceProtocol& upstream, usize initial_chunk_size = DEFAULT_CHUNK_SIZE);
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena(MonotonicArena&&) = delete;
+    auto operator=(const MonotonicArena&) -> MonotonicArena& = delete;
+    auto operator=(MonotonicArena&&) -> MonotonicArena& = delete;
+    ~MonotonicArena() override;
+
+    /** @brief Releases every allocation at once and returns all chunks upstream. */
+    auto reset() -> void;
+  };
+}  // namespace wesos::alloc
@@ -0,0 +1,73 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-cpu/Topology.hh>
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-sync/Atomic.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::alloc {
+  /**
+   * @brief Single-owner object pool that any CPU may free into.
+   *
+   * Only the owner allocates, and it does so from a private free list without
+   * atomics. Deallocations from any CPU are pushed onto a lock-free remote-free
+   * list with one compare-exchange. When the private list is empty, the owner
+   * takes the whole remote list with a single exchange and allocates from it.
+   * This suits producer/consumer patterns, where one side allocates and the
+   * other frees, without wrapping the pool in an `AtomicResource`.
+   *
+   * @note `allocate_bytes` and `utilize_bytes` must only be called by the owner.
+   * `deallocate_bytes` and `embezzle_bytes` may be called from anywhere.
+   */
+  class RemoteFreePool final : public mem::MemoryResourceProtocol {
+    template <class>
+    friend class mem::StaticResource;
+
+    struct FreeNode {
+      FreeNode* m_next;
+    };
+
+  public:
+    using ObjectSize = ClampLeast<usize, sizeof(FreeNode)>;
+
+  private:
+    NullableRefPtr<FreeNode> m_local;
+    ObjectSize m_object_size;
+    PowerOfTwo<usize> m_object_align;
+
+    /* Written by every freeing CPU; kept off the owner's cache line */
+    alignas(cpu::CACHE_LINE_SIZE) sync::Atomic<FreeNode*> m_remote;
+
+    [[nodiscard]] constexpr auto object_size() const { return m_object_size.unwrap(); }
+    [[nodiscard]] constexpr auto object_align() const { return m_object_align.unwrap(); }
+
+    auto push_remote(RefPtr<FreeNode> first, RefPtr<FreeNode> last) -> void;
+    [[nodiscard]] auto reclaim() -> bool;
+
+    [[nodiscard]] auto virt_embezzle(usize max_size) -> View<u8> override;
+    [[nodiscard]] auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
+    auto virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void override;
+    [[nodiscard]] auto virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize override;
+    auto virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void override;
+    auto virt_utilize(View<u8> pool) -> void override;
+    [[nodiscard]] auto virt_accepts_donations() const -> bool override;
+
+  public:
+    RemoteFreePool(ObjectSize object_size, PowerOfTwo<usize> object_align, View<u8> pool = View<u8>::create_empty());
+    RemoteFreePool(const RemoteFreePool&) = delete;
+    RemoteFreePool(RemoteFreePool&&) = delete;
+    auto operator=(const RemoteFreePool&) -> RemoteFreePool& = delete;
+    auto operator=(RemoteFreePool&&) -> RemoteFreePool& = delete;
+    ~RemoteFreePool() override = default;
+
+    [[nodiscard]] static constexpr auto minimum_size() { return sizeof(FreeNode); }
+    [[nodiscard]] static constexpr auto minimum_alignment() { return alignof(FreeNode); }
+  };
+}  // namespace wesos::alloc
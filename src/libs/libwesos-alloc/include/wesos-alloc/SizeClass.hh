@@ -0,0 +1,100 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-types/Types.hh>
+
+namespace wesos::alloc {
+  /**
+   * @brief Fixed table of small-object size classes.
+   *
+   * Every power of two from 32 bytes up to `MAX_SIZE` is split into four steps
+   * (1x, 1.25x, 1.5x, 1.75x), so no request is rounded up by more than 25%.
+   * Below 32 bytes the classes are 16 and 24. A class is naturally aligned to
+   * the largest power of two dividing its size (capped at `MAX_ALIGN`).
+   */
+  class SizeClass final {
+    static constexpr usize STEPS_PER_DOUBLING = 4;
+    static constexpr usize FIRST_STEPPED_SHIFT = 5;
+    static constexpr usize FIRST_STEPPED_INDEX = 2;
+    static constexpr usize MAX_SHIFT = 14;
+
+    [[nodiscard]] static constexpr auto bit_width(usize x) -> usize {
+      return x == 0 ? 0 : (sizeof(u64) * 8) - static_cast<usize>(__builtin_clzll(static_cast<u64>(x)));
+    }
+
+  public:
+    static constexpr usize MIN_SIZE = 16;
+    static constexpr usize MAX_SIZE = usize(1) << MAX_SHIFT;
+    static constexpr usize MAX_ALIGN = 4096;
+    static constexpr usize COUNT = FIRST_STEPPED_INDEX + 1 + ((MAX_SHIFT - FIRST_STEPPED_SHIFT) * STEPS_PER_DOUBLING);
+
+    SizeClass() = delete;
+
+    [[nodiscard]] static constexpr auto size_of(usize index) -> usize {
+      assert_invariant(index < COUNT);
+
+      if (index < FIRST_STEPPED_INDEX) {
+        return MIN_SIZE + (index * sizeof(void*));
+      }
+
+      const auto stepped = index - FIRST_STEPPED_INDEX;
+      if (stepped == 0) {
+        return usize(1) << FIRST_STEPPED_SHIFT;
+      }
+
+      const auto shift = FIRST_STEPPED_SHIFT + ((stepped - 1) / STEPS_PER_DOUBLING);
+      const auto step = (usize(1) << shift) / STEPS_PER_DOUBLING;
+
+      return (usize(1) << shift) + (step * (((stepped - 1) % STEPS_PER_DOUBLING) + 1));
+    }
+
+    [[nodiscard]] static constexpr auto align_of(usize index) -> PowerOfTwo<usize> {
+      const auto size = size_of(index);
+      return PowerOfTwo<usize>::create_unchecked(min(size & (~size + 1), MAX_ALIGN));
+    }
+
+    /**
+     * @brief Finds the smallest class that fits both the size and the alignment.
+     * @return The class index, or null if the request must be served by a large-object path.
+     */
+    [[nodiscard]] static constexpr auto index_of(usize size, PowerOfTwo<usize> align) -> Nullable<usize> {
+      if (size > MAX_SIZE || align > MAX_ALIGN) [[unlikely]] {
+        return null;
+      }
+
+      usize index = 0;
+
+      if (size > (usize(1) << FIRST_STEPPED_SHIFT)) {
+        const auto shift = bit_width(size - 1) - 1;
+        const auto step = (usize(1) << shift) / STEPS_PER_DOUBLING;
+        const auto steps = ((size - (usize(1) << shift)) + step - 1) / step;
+
+        index = FIRST_STEPPED_INDEX + ((shift - FIRST_STEPPED_SHIFT) * STEPS_PER_DOUBLING) + steps;
+      } else if (size > MIN_SIZE + sizeof(void*)) {
+        index = FIRST_STEPPED_INDEX;
+      } else if (size > MIN_SIZE) {
+        index = 1;
+      }
+
+      /* At most one doubling away there is a class aligned to its own size */
+      while (index < COUNT && align_of(index) < align.unwrap()) {
+        ++index;
+      }
+
+      if (index >= COUNT) [[unlikely]] {
+        return null;
+      }
+
+      return index;
+    }
+  };
+
+  static_assert(SizeClass::size_of(0) == SizeClass::MIN_SIZE);
+  static_assert(SizeClass::size_of(SizeClass::COUNT - 1) == SizeClass::MAX_SIZE);
+}  // namespace wesos::alloc
@@ -0,0 +1,74 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-alloc/IntrusivePool.hh>
+#include <wesos-alloc/SizeClass.hh>
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::alloc {
+  /**
+   * @brief Size-class slab allocator.
+   *
+   * Requests up to `SizeClass::MAX_SIZE` are served in O(1) from one `IntrusivePool`
+   * per size class. When a class runs dry, a new slab is taken from the backing
+   * resource and handed to that class's pool. Larger requests are forwarded to the
+   * backing resource unchanged. All slabs are returned to the backing resource on
+   * destruction.
+   *
+   * @note This resource is not thread-safe. Wrap it in an `AtomicResource` if needed.
+   */
+  class SlabResource final : public mem::MemoryResourceProtocol {
+    template <class>
+    friend class mem::StaticResource;
+
+    struct Slab {
+      NullableRefPtr<Slab> m_next;
+      usize m_size;
+      PowerOfTwo<usize> m_align;
+
+      constexpr Slab(NullableRefPtr<Slab> next, usize size, PowerOfTwo<usize> align)
+          : m_next(next), m_size(size), m_align(align) {}
+    };
+
+    mem::MemoryResourceProtocol& m_backing;
+    NullableRefPtr<Slab> m_slabs;
+    usize m_min_slab_size;
+    alignas(IntrusivePool) Array<u8, sizeof(IntrusivePool) * SizeClass::COUNT> m_pools;
+
+    [[nodiscard]] auto pool(usize index) -> IntrusivePool&;
+    [[nodiscard]] auto refill(usize index) -> bool;
+
+    [[nodiscard]] auto virt_embezzle(usize max_size) -> View<u8> override;
+    [[nodiscard]] auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
+    auto virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void override;
+    [[nodiscard]] auto virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize override;
+    auto virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void override;
+    auto virt_utilize(View<u8> pool) -> void override;
+
+  public:
+    static constexpr usize MIN_SLAB_SIZE = 4096;
+    static constexpr usize MIN_SLAB_OBJECTS = 8;
+
+    /**
+     * @param min_slab_size Smallest slab taken from the backing resource. Lower it
+     * when the backing resource starts out small, e.g. while bootstrapping.
+     */
+    SlabResource(mem::MemoryResourceProtocol& backing, usize min_slab_size = MIN_SLAB_SIZE);
+    SlabResource(const SlabResource&) = delete;
+    SlabResource(SlabResource&&) = delete;
+    auto operator=(const SlabResource&) -> SlabResource& = delete;
+    auto operator=(SlabResource&&) -> SlabResource& = delete;
+    ~SlabResource() override;
+
+    [[nodiscard]] constexpr auto slab_size(usize index) const -> usize {
+      return max(m_min_slab_size, SizeClass::size_of(index) * MIN_SLAB_OBJECTS);
+    }
+  };
+}  // namespace wesos::alloc
@@ -0,0 +1,71 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-alloc/BuddyResource.hh>
+#include <wesos-alloc/FreeList.hh>
+#include <wesos-alloc/SlabResource.hh>
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::alloc {
+  /**
+   * @brief General-purpose allocator that starts from a few KiB and grows with every pool it is given.
+   *
+   * There are three tiers:
+   * - Requests that fit a `SizeClass` come from a `SlabResource`.
+   * - Larger requests come from a `BuddyResource` when it can serve them.
+   * - Everything else comes from a `FreeList`, which also holds the slabs.
+   *
+   * Pools given to `utilize_bytes` that are at least `PAGE_POOL_MIN_SIZE` go to the
+   * buddy tier, and smaller ones (such as the `Kickstart` buffer) go to the free
+   * list. When the free list runs dry it takes `GENERAL_GROW_SIZE` or more from the
+   * buddy tier. That memory never goes back.
+   *
+   * Large blocks are freed to the tier that served them. Only the buddy tier hands
+   * out blocks that start on one of its allocated pages, so `BuddyResource::owns`
+   * decides; everything else, including large blocks the free list served from
+   * memory it took from the buddy tier, goes back to the free list.
+   *
+   * @note This resource is not thread-safe. Wrap it in an `AtomicResource` if needed.
+   */
+  class TieredResource final : public mem::MemoryResourceProtocol {
+    template <class>
+    friend class mem::StaticResource;
+
+  public:
+    static constexpr usize PAGE_POOL_MIN_SIZE = BuddyResource::PAGE_SIZE * 16;
+    static constexpr usize GENERAL_GROW_SIZE = BuddyResource::PAGE_SIZE * 16;
+    static constexpr usize BOOTSTRAP_SLAB_SIZE = 512;
+
+  private:
+    /* Bytes at the head of each span lent to the free list that it never sees */
+    static constexpr usize SPAN_GUARD_SIZE = 16;
+
+    BuddyResource m_pages;
+    FreeList m_general;
+    SlabResource m_slabs;
+
+    [[nodiscard]] auto grow_general(usize size, PowerOfTwo<usize> align) -> bool;
+    [[nodiscard]] auto allocate_large(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void>;
+
+    [[nodiscard]] auto virt_embezzle(usize max_size) -> View<u8> override;
+    [[nodiscard]] auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
+    auto virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void override;
+    auto virt_utilize(View<u8> pool) -> void override;
+    [[nodiscard]] auto virt_accepts_donations() const -> bool override;
+
+  public:
+    TieredResource(View<u8> pool = View<u8>::create_empty());
+    TieredResource(const TieredResource&) = delete;
+    TieredResource(TieredResource&&) = delete;
+    auto operator=(const TieredResource&) -> TieredResource& = delete;
+    auto operator=(TieredResource&&) -> TieredResource& = delete;
+    ~TieredResource() override = default;
+  };
+}  // namespace wesos::alloc
@@ -0,0 +1,224 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#if __SANITIZE_ADDRESS__ || (defined(__has_feature) && __has_feature(address_sanitizer))
+#include <sanitizer/asan_interface.h>
+#elif !defined(__SANITIZE_ADDRESS__)
+// #warning "Building memory allocator without address -fsanitize=address enabled"
+
+#define ASAN_POISON_MEMORY_REGION(addr, size) ((void)(addr), (void)(size))
+#define ASAN_UNPOISON_MEMORY_REGION(addr, size) ((void)(addr), (void)(size))
+#endif
+
+#include <wesos-alloc/AtomicIntrusivePool.hh>
+#include <wesos-builtin/Export.hh>
+
+using namespace wesos;
+using namespace wesos::mem;
+using namespace wesos::alloc;
+
+SYM_EXPORT AtomicIntrusivePool::AtomicIntrusivePool(ObjectSize object_size, PowerOfTwo<usize> object_align,
+                                                    View<u8> pool)
+    : m_front(0), m_object_size(object_size), m_object_align(max(object_align.unwrap(), alignof(FreeNode))) {
+  AtomicIntrusivePool::virt_utilize(pool);
+}
+
+SYM_EXPORT AtomicIntrusivePool::~AtomicIntrusivePool() {
+  auto* node = unpack_node(m_front.load(sync::memory_order_acquire));
+  while (node != nullptr) {
+    ASAN_UNPOISON_MEMORY_REGION(node, object_size());
+    node = node->m_next.load(sync::memory_order_relaxed);
+  }
+}
+
+auto AtomicIntrusivePool::push_chain(RefPtr<FreeNode> first, RefPtr<FreeNode> last) -> void {
+  auto head = m_front.load(sync::memory_order_relaxed);
+
+  do {
+    last->m_next.store(unpack_node(head), sync::memory_order_relaxed);
+  } while (!m_front.compare_exchange_weak(head, pack(first.unwrap(), unpack_tag(head) + 1),
+                                          sync::memory_order_release, sync::memory_order_relaxed));
+}
+
+auto AtomicIntrusivePool::pop() -> NullableRefPtr<FreeNode> {
+  auto head = m_front.load(sync::memory_order_acquire);
+
+  while (true) {
+    auto* node = unpack_node(head);
+    if (node == nullptr) [[unlikely]] {
+      return null;
+    }
+
+    /* The node may be popped and reused under us; the tag makes the CAS below fail if so */
+    const auto next = pack(node->m_next.load(sync::memory_order_relaxed), unpack_tag(head) + 1);
+
+    if (m_front.compare_exchange_weak(head, next, sync::memory_order_acquire, sync::memory_order_acquire)) [[likely]] {
+      return node;
+    }
+  }
+}
+
+auto AtomicIntrusivePool::pop_chain(View<void*> out) -> usize {
+  auto head = m_front.load(sync::memory_order_acquire);
+
+  while (true) {
+    auto* node = unpack_node(head);
+    usize count = 0;
+    bool stale = false;
+
+    while (node != nullptr && count < out.size()) {
+      /* Only follow a link read from a node that was still on the list after reading it */
+      if (count != 0) {
+        sync::atomic_thread_fence(sync::memory_order_acquire);
+        if (m_front.load(sync::memory_order_relaxed) != head) [[unlikely]] {
+          stale = true;
+          break;
+        }
+      }
+
+      out.set_unchecked(count++, node);
+      node = node->m_next.load(sync::memory_order_relaxed);
+    }
+
+    if (stale) [[unlikely]] {
+      head = m_front.load(sync::memory_order_acquire);
+      continue;
+    }
+
+    if (count == 0) [[unlikely]] {
+      return 0;
+    }
+
+    if (m_front.compare_exchange_weak(head, pack(node, unpack_tag(head) + 1), sync::memory_order_acquire,
+                                      sync::memory_order_acquire)) [[likely]] {
+      return count;
+    }
+  }
+}
+
+SYM_EXPORT auto AtomicIntrusivePool::virt_embezzle(usize max_size) -> View<u8> {
+  /* Free objects are not contiguous, so give them away one at a time */
+  if (object_size() > max_size) {
+    return View<u8>::create_empty();
+  }
+
+  const auto freenode = pop();
+  if (freenode.is_null()) {
+    return View<u8>::create_empty();
+  }
+
+  ASAN_UNPOISON_MEMORY_REGION(freenode.unwrap(), object_size());
+
+  return View<u8>(bit_cast<u8*>(freenode.unwrap()), object_size());
+}
+
+SYM_EXPORT auto AtomicIntrusivePool::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  size = max(size, sizeof(FreeNode));
+
+  if (size > object_size() || align > object_align()) [[unlikely]] {
+    return nullptr;
+  }
+
+  const auto freenode = pop();
+  if (freenode.is_null()) [[unlikely]] {
+    return nullptr;
+  }
+
+  ASAN_UNPOISON_MEMORY_REGION(freenode.unwrap(), size);
+
+  const auto result = OwnPtr(bit_cast<u8*>(freenode.unwrap()));
+  assert_invariant(is_aligned_pow2(result, align));
+
+  return result.unwrap();
+}
+
+SYM_EXPORT void AtomicIntrusivePool::virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) {
+  assert_invariant(size <= object_size() && max(align.unwrap(), alignof(FreeNode)) == object_align());
+
+  const auto node = OwnPtr(bit_cast<FreeNode*>(ptr.unwrap()));
+
+  /* The link stays unpoisoned; concurrent pops may still read it */
+  ASAN_POISON_MEMORY_REGION(bit_cast<u8*>(ptr.unwrap()) + sizeof(FreeNode), object_size() - sizeof(FreeNode));
+
+  push_chain(node, node);
+}
+
+SYM_EXPORT auto AtomicIntrusivePool::virt_allocate_bulk(View<void*> out, usize size,
+                                                        PowerOfTwo<usize> align) -> usize {
+  size = max(size, sizeof(FreeNode));
+
+  if (size > object_size() || align > object_align()) [[unlikely]] {
+    return 0;
+  }
+
+  const auto count = pop_chain(out);
+
+  for (usize i = 0; i < count; i++) {
+    ASAN_UNPOISON_MEMORY_REGION(out.get_unchecked(i), size);
+    assert_invariant(is_aligned_pow2(OwnPtr(bit_cast<u8*>(out.get_unchecked(i))), align));
+  }
+
+  return count;
+}
+
+SYM_EXPORT auto AtomicIntrusivePool::virt_deallocate_bulk(View<void*> ptrs, usize size,
+                                                          PowerOfTwo<usize> align) -> void {
+  assert_invariant(size <= object_size() && max(align.unwrap(), alignof(FreeNode)) == object_align());
+
+  /* Link the batch privately, then publish it with a single CAS */
+  NullableRefPtr<FreeNode> first;
+  NullableRefPtr<FreeNode> last;
+
+  for (auto* ptr : ptrs) {
+    if (ptr == nullptr) {
+      continue;
+    }
+
+    const auto node = bit_cast<FreeNode*>(ptr);
+    node->m_next.store(first.unwrap(), sync::memory_order_relaxed);
+    ASAN_POISON_MEMORY_REGION(bit_cast<u8*>(ptr) + sizeof(FreeNode), object_size() - sizeof(FreeNode));
+
+    if (last.is_null()) {
+      last = node;
+    }
+    first = node;
+  }
+
+  if (first.isset()) {
+    push_chain(first.get_unchecked(), last.get_unchecked());
+  }
+}
+
+SYM_EXPORT auto AtomicIntrusivePool::virt_utilize(View<u8> pool) -> void {
+  if (pool.empty()) [[unlikely]] {
+    return;
+  }
+
+  /* Link the new objects privately, then publish them with a single CAS */
+  NullableRefPtr<FreeNode> first;
+  NullableRefPtr<FreeNode> last;
+
+  for_each_chunk_aligned(pool, object_size(), object_align(), [&](auto object_range) {
+    const auto object_ptr = OwnPtr(object_range.into_ptr().get_unchecked().unwrap());
+    assert_invariant(object_range.size() == object_size() && is_aligned_pow2(object_ptr, object_align()));
+
+    const auto node = ::new (object_ptr.unwrap()) FreeNode();
+    node->m_next.store(first.unwrap(), sync::memory_order_relaxed);
+    ASAN_POISON_MEMORY_REGION(object_ptr.unwrap() + sizeof(FreeNode), object_size() - sizeof(FreeNode));
+
+    if (last.is_null()) {
+      last = node;
+    }
+    first = node;
+  });
+
+  if (first.isset()) {
+    push_chain(first.get_unchecked(), last.get_unchecked());
+  }
+}
+
+SYM_EXPORT auto AtomicIntrusivePool::virt_accepts_donations() const -> bool { return true; }
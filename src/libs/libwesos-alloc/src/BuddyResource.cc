@@ -0,0 +1,192 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-alloc/BuddyResource.hh>
+#include <wesos-builtin/Export.hh>
+
+using namespace wesos;
+using namespace wesos::mem;
+using namespace wesos::alloc;
+
+auto BuddyResource::Region::page_state(uptr pfn) -> u8& {
+  assert_invariant(contains_pfn(pfn));
+  return bit_cast<u8*>(this + 1)[pfn - m_first_pfn];
+}
+
+SYM_EXPORT BuddyResource::BuddyResource(View<u8> pool) { BuddyResource::virt_utilize(pool); }
+
+auto BuddyResource::region_of(uptr pfn) -> NullableRefPtr<Region> {
+  NullableRefPtr<Region> prev;
+
+  for (auto region = m_regions; region.isset(); prev = region, region = region->m_next) {
+    if (region->contains_pfn(pfn)) {
+      if (prev.isset()) {
+        prev->m_next = region->m_next;
+        region->m_next = m_regions;
+        m_regions = region;
+      }
+
+      return region;
+    }
+  }
+
+  return null;
+}
+
+SYM_EXPORT auto BuddyResource::owns(const void* ptr) -> bool {
+  if (bit_cast<uptr>(ptr) % PAGE_SIZE != 0) {
+    return false;
+  }
+
+  const auto pfn = pfn_of(ptr);
+  const auto region = region_of(pfn);
+
+  return region.isset() && (region->page_state(pfn) & PAGE_ALLOCATED) != 0;
+}
+
+auto BuddyResource::push_free(Region& region, uptr pfn, usize order) -> void {
+  const auto block = block_of(pfn);
+  auto& head = m_free.get_unchecked(order);
+
+  block->m_prev = null;
+  block->m_next = head;
+  if (head.isset()) {
+    head->m_prev = block;
+  }
+  head = block;
+
+  region.page_state(pfn) = PAGE_FREE | u8(order);
+  m_free_bytes += PAGE_SIZE << order;
+}
+
+auto BuddyResource::remove_free(Region& region, uptr pfn, usize order) -> void {
+  const auto block = block_of(pfn);
+
+  if (block->m_prev.isset()) {
+    block->m_prev->m_next = block->m_next;
+  } else {
+    m_free.get_unchecked(order) = block->m_next;
+  }
+
+  if (block->m_next.isset()) {
+    block->m_next->m_prev = block->m_prev;
+  }
+
+  region.page_state(pfn) = 0;
+  m_free_bytes -= PAGE_SIZE << order;
+}
+
+SYM_EXPORT auto BuddyResource::virt_embezzle(usize max_size) -> View<u8> {
+  /* Hand out the largest whole free block that fits; its pages never merge again */
+  for (usize order = ORDER_COUNT; order-- > 0;) {
+    const auto block = m_free.get_unchecked(order);
+    if ((PAGE_SIZE << order) > max_size || block.is_null()) {
+      continue;
+    }
+
+    const auto pfn = pfn_of(block.unwrap());
+    remove_free(*region_of(pfn).get_unchecked(), pfn, order);
+
+    return View<u8>(bit_cast<u8*>(block.unwrap()), PAGE_SIZE << order);
+  }
+
+  return View<u8>::create_empty();
+}
+
+SYM_EXPORT auto BuddyResource::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  const auto wanted = order_of(size, align);
+  if (wanted.is_null()) [[unlikely]] {
+    return null;
+  }
+
+  const auto order = wanted.value_unchecked();
+
+  auto found = order;
+  while (found < ORDER_COUNT && m_free.get_unchecked(found).is_null()) {
+    ++found;
+  }
+
+  if (found == ORDER_COUNT) [[unlikely]] {
+    return null;
+  }
+
+  const auto block = m_free.get_unchecked(found).get_unchecked();
+  const auto pfn = pfn_of(block.unwrap());
+  auto& region = *region_of(pfn).get_unchecked();
+
+  remove_free(region, pfn, found);
+
+  while (found > order) {
+    --found;
+    push_free(region, pfn + (uptr(1) << found), found);
+  }
+
+  region.page_state(pfn) = PAGE_ALLOCATED | u8(order);
+
+  return block.unwrap();
+}
+
+SYM_EXPORT void BuddyResource::virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) {
+  const auto freed = order_of(size, align);
+  assert_invariant(freed.isset() && is_aligned_pow2(ptr, PAGE_SIZE));
+
+  auto order = freed.value_unchecked();
+  auto pfn = pfn_of(ptr.unwrap());
+
+  const auto found_region = region_of(pfn);
+  assert_invariant(found_region.isset());
+
+  auto& region = *found_region.get_unchecked();
+  assert_invariant(region.page_state(pfn) == (PAGE_ALLOCATED | order));
+  region.page_state(pfn) = 0;
+
+  while (order < MAX_ORDER) {
+    const auto buddy = pfn ^ (uptr(1) << order);
+    if (!region.contains_pfn(buddy) || region.page_state(buddy) != (PAGE_FREE | order)) {
+      break;
+    }
+
+    remove_free(region, buddy, order);
+    pfn = min(pfn, buddy);
+    ++order;
+  }
+
+  push_free(region, pfn, order);
+}
+
+SYM_EXPORT auto BuddyResource::virt_utilize(View<u8> pool) -> void {
+  pool.align_or_truncate_to(PAGE_SIZE);
+
+  const auto page_count = pool.size() / PAGE_SIZE;
+  const auto meta_pages = (sizeof(Region) + page_count + PAGE_SIZE - 1) / PAGE_SIZE;
+  if (page_count <= meta_pages) [[unlikely]] {
+    return;
+  }
+
+  const auto first_pfn = pfn_of(pool.into_ptr().unwrap()) + meta_pages;
+  const auto end_pfn = first_pfn + (page_count - meta_pages);
+
+  auto& region = *::new (pool.into_ptr().unwrap()) Region(m_regions, first_pfn, end_pfn - first_pfn);
+  for (auto pfn = first_pfn; pfn < end_pfn; ++pfn) {
+    region.page_state(pfn) = 0;
+  }
+
+  m_regions = &region;
+
+  /* Carve the range into the largest naturally aligned blocks that fit */
+  for (auto pfn = first_pfn; pfn < end_pfn;) {
+    usize order = MAX_ORDER;
+    while (order > 0 && ((pfn & ((uptr(1) << order) - 1)) != 0 || pfn + (uptr(1) << order) > end_pfn)) {
+      --order;
+    }
+
+    push_free(region, pfn, order);
+    pfn += uptr(1) << order;
+  }
+}
+
+SYM_EXPORT auto BuddyResource::virt_accepts_donations() const -> bool { return true; }
@@ -21,122 +21,246 @@ using namespace wesos;
 using namespace wesos::mem;
 using namespace wesos::alloc;
 
+static constexpr auto floor_log2(usize x) -> usize {
+  return (sizeof(u64) * 8) - 1 - static_cast<usize>(__builtin_clzll(static_cast<u64>(x)));
+}
+
+static constexpr auto round_up(uptr x, usize align) -> uptr { return (x + align - 1) & ~(uptr(align) - 1); }
+
 SYM_EXPORT FreeList::FreeList(View<u8> pool) { FreeList::virt_utilize(pool); }
-SYM_EXPORT FreeList::~FreeList() = default;
 
-SYM_EXPORT auto FreeList::virt_embezzle(usize max_size) -> View<u8> {
-  // TODO: Implement memory embezzelment
-  (void)max_size;
-  return View<u8>::create_empty();
+SYM_EXPORT FreeList::~FreeList() {
+  for (auto& fl : m_bins) {
+    for (auto chunk : fl) {
+      for (; chunk.isset(); chunk = chunk->m_next) {
+        const auto block = block_of(chunk.get_unchecked());
+        ASAN_UNPOISON_MEMORY_REGION(bit_cast<void*>(block), tag_at(block) & ~TAG_FREE);
+      }
+    }
+  }
 }
 
-SYM_EXPORT auto FreeList::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
-  size = max(size, sizeof(Chunk));
+auto FreeList::mapping_insert(usize block_size) -> Bin {
+  if (block_size < SMALL_BLOCK_SIZE) {
+    return {0, block_size / GRANULE};
+  }
 
-  if (!m_front.isset() || align > alignof(Chunk)) [[unlikely]] {
-    return nullptr;
+  const auto fl = floor_log2(block_size);
+  return {fl - FL_SHIFT + 1, (block_size >> (fl - SL_SHIFT)) ^ SL_COUNT};
+}
+
+auto FreeList::mapping_search(usize block_size) -> Nullable<Bin> {
+  /* Round up to the next bin so that any block found there is large enough */
+  if (block_size >= SMALL_BLOCK_SIZE) {
+    block_size += (usize(1) << (floor_log2(block_size) - SL_SHIFT)) - 1;
+  }
+
+  if (block_size >= MAX_BLOCK_SIZE) [[unlikely]] {
+    return null;
   }
 
-  assert_invariant(max(align.unwrap(), alignof(Chunk)) == alignof(Chunk));
+  return mapping_insert(block_size);
+}
 
-  struct Best {
-    NullableRefPtr<Chunk> m_node;
-    NullableRefPtr<Chunk> m_prev;
-    usize m_size = 0;
-  };
+auto FreeList::find_free(usize block_size) -> NullableRefPtr<Chunk> {
+  const auto bin = mapping_search(block_size);
+  if (bin.is_null()) [[unlikely]] {
+    return null;
+  }
 
-  Nullable<Best> bestfit;
+  auto [fl, sl] = bin.value_unchecked();
+  auto sl_map = m_sl_bitmap.get_unchecked(fl) & (~u32(0) << sl);
 
-  for (NullableRefPtr<Chunk> current = m_front, prev = null; current.isset();
-       prev = current, current = current->m_next) {
-    if (current->m_size < size || current->m_size < align.unwrap() || !is_aligned_pow2(current, align)) {
-      continue;
+  if (sl_map == 0) {
+    const auto fl_map = m_fl_bitmap & (~u64(0) << (fl + 1));
+    if (fl_map == 0) [[unlikely]] {
+      return null;
     }
 
-    if (!bestfit.isset() || current->m_size < bestfit->m_size) {
-      bestfit = Best{current, prev, current->m_size};
+    fl = static_cast<usize>(__builtin_ctzll(fl_map));
+    sl_map = m_sl_bitmap.get_unchecked(fl);
+  }
+
+  sl = static_cast<usize>(__builtin_ctz(sl_map));
+
+  return m_bins.get_unchecked(fl).get_unchecked(sl);
+}
+
+auto FreeList::insert_free(RefPtr<Chunk> chunk, usize block_size) -> void {
+  const auto [fl, sl] = mapping_insert(block_size);
+  auto& head = m_bins.get_unchecked(fl).get_unchecked(sl);
+
+  write_tags(block_of(chunk), block_size, TAG_FREE);
+
+  chunk->m_prev = null;
+  chunk->m_next = head;
+  if (head.isset()) {
+    head->m_prev = chunk;
+  }
+  head = chunk;
+
+  m_sl_bitmap.get_unchecked(fl) |= u32(1) << sl;
+  m_fl_bitmap |= u64(1) << fl;
+
+  const auto poison_begin = bit_cast<u8*>(chunk.unwrap()) + sizeof(Chunk);
+  ASAN_POISON_MEMORY_REGION(poison_begin, block_size - sizeof(Chunk) - (2 * TAG_SIZE));
+}
+
+auto FreeList::remove_free(RefPtr<Chunk> chunk, usize block_size) -> void {
+  ASAN_UNPOISON_MEMORY_REGION(bit_cast<void*>(block_of(chunk)), block_size);
+
+  const auto [fl, sl] = mapping_insert(block_size);
+
+  if (chunk->m_prev.isset()) {
+    chunk->m_prev->m_next = chunk->m_next;
+  } else {
+    auto& head = m_bins.get_unchecked(fl).get_unchecked(sl);
+    head = chunk->m_next;
+
+    if (head.is_null()) {
+      m_sl_bitmap.get_unchecked(fl) &= ~(u32(1) << sl);
+      if (m_sl_bitmap.get_unchecked(fl) == 0) {
+        m_fl_bitmap &= ~(u64(1) << fl);
+      }
     }
   }
 
-  if (!bestfit.isset()) [[unlikely]] {
-    return nullptr;
+  if (chunk->m_next.isset()) {
+    chunk->m_next->m_prev = chunk->m_prev;
   }
+}
 
-  const auto freenode = bestfit->m_node;
-  const auto prevnode = bestfit->m_prev;
-  const auto freesize = bestfit->m_size;
+auto FreeList::take_block(RefPtr<Chunk> chunk, usize block_size, usize leading, usize needed) -> RefPtr<u8> {
+  /* The block was fully coalesced, so both of its neighbors are in use and the
+   * leftovers on either side can go straight back to the bins. */
+  auto block = block_of(chunk);
 
-  return null;
+  if (leading != 0) {
+    assert_invariant(leading >= MIN_BLOCK_SIZE && leading % GRANULE == 0);
+    insert_free(chunk, leading);
+    block += leading;
+    block_size -= leading;
+  }
 
-  // const auto freenode = m_front;
-  // ASAN_UNPOISON_MEMORY_REGION(freenode.unwrap(), size);
+  assert_invariant(block_size >= needed);
 
-  // m_front = freenode->m_next;
+  if (block_size - needed >= MIN_BLOCK_SIZE) {
+    insert_free(chunk_of(block + needed), block_size - needed);
+    block_size = needed;
+  }
 
-  // const auto result = OwnPtr(bit_cast<u8*>(freenode.unwrap()));
-  // assert_invariant(is_aligned_pow2(result, align));
+  write_tags(block, block_size, 0);
+  m_statistics.m_total_memory_allocated_bytes += block_size;
 
-  // return result.unwrap();
+  return bit_cast<u8*>(block + TAG_SIZE);
 }
 
-SYM_EXPORT void FreeList::virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) {
-  const auto ptr_u8 = OwnPtr(static_cast<u8*>(ptr.unwrap()));
-  const auto chunk_size_ptr = OwnPtr(bit_cast<usize*>(ptr_u8.sub(sizeof(usize))));
-  assert_invariant(is_aligned_pow2(chunk_size_ptr, alignof(usize)));
-
-  const auto chunk_size = *chunk_size_ptr;
-  const auto chunk_start = ptr_u8.sub(sizeof(usize));
-  const auto chunk_end = chunk_start.add(chunk_size);
-
-  //=========================================================================================
-  // TODO: Reason about this code
-  //=========================================================================================
-
-  for (NullableRefPtr<Chunk> current = m_front, prev = null; current.isset();
-       prev = current, current = current->m_next) {
-    u8* current_start = bit_cast<u8*>(current.unwrap());
-    u8* current_end = current_start + current->m_size;
-
-    // Check if `current` ends at the start of the chunk we are deallocating
-    if (current_end == chunk_start.unwrap() - 1) {
-      current->m_size += chunk_size;
-    } else if (current_start == chunk_end.unwrap() + 1) {
-      // TODO: Handle merging with the next chunk
-      return;
-    }
+SYM_EXPORT auto FreeList::virt_embezzle(usize max_size) -> View<u8> {
+  const auto payload_limit = max_size & ~(GRANULE - 1);
+  if (m_fl_bitmap == 0 || payload_limit < sizeof(Chunk)) [[unlikely]] {
+    return View<u8>::create_empty();
   }
 
-  // If we reach here, it means we need to create a new chunk
-  auto* freenode_vp = bit_cast<void*>(chunk_start.unwrap());
-  const auto freenode = RefPtr<Chunk>(new (freenode_vp) Chunk());
+  /* Carve from the largest free block; the piece becomes a permanently allocated block */
+  const auto fl = floor_log2(m_fl_bitmap);
+  const auto sl = floor_log2(m_sl_bitmap.get_unchecked(fl));
+  const auto chunk = m_bins.get_unchecked(fl).get_unchecked(sl).get_unchecked();
+  const auto block_size = tag_at(block_of(chunk)) & ~TAG_FREE;
+
+  const auto payload = min(payload_limit, block_size - (2 * TAG_SIZE));
 
-  freenode->m_size = chunk_size;
-  freenode->m_next = m_front;
+  remove_free(chunk, block_size);
+  const auto ptr = take_block(chunk, block_size, 0, payload + (2 * TAG_SIZE));
 
-  m_front = freenode;
+  const auto taken = tag_at(bit_cast<uptr>(ptr.unwrap()) - TAG_SIZE);
+  m_statistics.m_total_memory_allocated_bytes -= taken;
+  m_statistics.m_total_memory_managed_bytes -= taken;
 
-  //=========================================================================================
+  return View<u8>(ptr.unwrap(), payload);
 }
 
-SYM_EXPORT auto FreeList::virt_utilize(View<u8> pool) -> void {
-  static_assert(sizeof(Chunk) > sizeof(usize), "Chunk size must be at least the size of a pointer");
-  static_assert(alignof(Chunk) == alignof(usize), "Chunk alignment must match pointer alignment");
+SYM_EXPORT auto FreeList::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  if (size >= MAX_BLOCK_SIZE || align >= MAX_BLOCK_SIZE) [[unlikely]] {
+    return null;
+  }
+
+  const auto needed = round_up(max(size, sizeof(Chunk)), GRANULE) + (2 * TAG_SIZE);
+  const auto over_aligned = align > GRANULE;
+  const auto search = over_aligned ? needed + align.unwrap() + MIN_BLOCK_SIZE : needed;
 
-  /// FIXME: Keep track of discarded leading bytes
-  pool.align_or_truncate_to(alignof(Chunk));
-  if (pool.size() < sizeof(Chunk)) [[unlikely]] {
-    return;
+  const auto found = find_free(search);
+  if (found.is_null()) [[unlikely]] {
+    return null;
   }
 
-  const auto chunk_size = pool.size();
-  const auto chunk_base = OwnPtr(pool.into_ptr().get().cast_to<u8>().unwrap());
-  const auto region_size = chunk_size - sizeof(usize);
-  const auto region_ptr = chunk_base.add(sizeof(usize)).cast_to<void>();
+  const auto chunk = found.get_unchecked();
+  const auto block_size = tag_at(block_of(chunk)) & ~TAG_FREE;
+  remove_free(chunk, block_size);
 
-  assert_invariant(is_aligned_pow2(chunk_base, alignof(Chunk)));
-  assert_invariant(is_aligned_pow2(region_ptr, alignof(usize)));
+  usize leading = 0;
+  if (over_aligned) {
+    const auto payload = bit_cast<uptr>(chunk.unwrap());
 
-  new (chunk_base.unwrap()) usize(chunk_size);
+    leading = round_up(payload, align) - payload;
+    if (leading != 0 && leading < MIN_BLOCK_SIZE) {
+      leading = round_up(payload + MIN_BLOCK_SIZE, align) - payload;
+    }
+  }
+
+  const auto result = take_block(chunk, block_size, leading, needed);
+  assert_invariant(is_aligned_pow2(result, align));
+
+  m_statistics.m_accumulated_allocations_bytes += size;
 
-  deallocate_bytes(region_ptr, region_size, alignof(Chunk));
+  return result.unwrap();
 }
+
+SYM_EXPORT void FreeList::virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize>) {
+  auto block = bit_cast<uptr>(ptr.unwrap()) - TAG_SIZE;
+  auto block_size = tag_at(block);
+  assert_invariant((block_size & TAG_FREE) == 0 && block_size >= size + (2 * TAG_SIZE));
+
+  m_statistics.m_total_memory_allocated_bytes -= block_size;
+  m_statistics.m_accumulated_deallocations_bytes += size;
+
+  if (const auto prev_tag = tag_at(block - TAG_SIZE); (prev_tag & TAG_FREE) != 0) {
+    const auto prev_size = prev_tag & ~TAG_FREE;
+    block -= prev_size;
+    block_size += prev_size;
+    remove_free(chunk_of(block), prev_size);
+  }
+
+  if (const auto next_tag = tag_at(block + block_size); (next_tag & TAG_FREE) != 0) {
+    const auto next_size = next_tag & ~TAG_FREE;
+    remove_free(chunk_of(block + block_size), next_size);
+    block_size += next_size;
+  }
+
+  insert_free(chunk_of(block), block_size);
+}
+
+SYM_EXPORT auto FreeList::virt_utilize(View<u8> pool) -> void {
+  /* Each region is framed by an in-use footer (prologue) and header (epilogue) so
+   * coalescing never walks off its ends. Payloads land on GRANULE boundaries. */
+  auto start = bit_cast<uptr>(pool.into_ptr().unwrap());
+  const auto end = start + pool.size();
+
+  while (true) {
+    const auto block = round_up(start + (2 * TAG_SIZE), GRANULE) - TAG_SIZE;
+    if (end < block || end - block < MIN_BLOCK_SIZE + TAG_SIZE) {
+      return;
+    }
+
+    const auto block_size = min((end - block - TAG_SIZE) & ~(GRANULE - 1), MAX_BLOCK_SIZE - GRANULE);
+
+    tag_at(block - TAG_SIZE) = 0;
+    tag_at(block + block_size) = 0;
+    insert_free(chunk_of(block), block_size);
+
+    m_statistics.m_total_memory_managed_bytes += block_size;
+
+    start = block + block_size + TAG_SIZE;
+  }
+}
+
+SYM_EXPORT auto FreeList::virt_accepts_donations() const -> bool { return true; }
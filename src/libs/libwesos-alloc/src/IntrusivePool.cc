@@ -22,7 +22,10 @@ using namespace wesos::mem;
 using namespace wesos::alloc;
 
 SYM_EXPORT IntrusivePool::IntrusivePool(ObjectSize object_size, PowerOfTwo<usize> object_align, View<u8> pool)
-    : m_front(nullptr), m_object_size(object_size), m_object_align(max(object_align.unwrap(), alignof(FreeNode))) {
+    : m_front(nullptr),
+      m_frontier(View<u8>::create_empty()),
+      m_object_size(object_size),
+      m_object_align(max(object_align.unwrap(), alignof(FreeNode))) {
   IntrusivePool::virt_utilize(pool);
 }
 
@@ -32,21 +35,64 @@ SYM_EXPORT IntrusivePool::~IntrusivePool() {
     ASAN_UNPOISON_MEMORY_REGION(node, object_size());
     node = node->m_next;
   }
+
+  ASAN_UNPOISON_MEMORY_REGION(m_frontier.into_ptr().unwrap(), m_frontier.size());
+}
+
+auto IntrusivePool::carve() -> NullableOwnPtr<u8> {
+  const auto left_pad = bytes_until_next_aligned_pow2(m_frontier.into_ptr(), object_align());
+  if (m_frontier.size() < left_pad + object_size()) [[unlikely]] {
+    return nullptr;
+  }
+
+  const auto object = m_frontier.subview_unchecked(left_pad, object_size());
+  m_frontier = m_frontier.subview_unchecked(left_pad + object_size());
+
+  return object.into_ptr().unwrap();
 }
 
 SYM_EXPORT auto IntrusivePool::virt_embezzle(usize max_size) -> View<u8> {
-  // TODO: Implement memory embezzelment
-  (void)max_size;
-  return View<u8>::create_empty();
+  /* The untouched frontier is contiguous, so give its tail away first */
+  if (!m_frontier.empty() && max_size != 0) {
+    const auto size = min(max_size, m_frontier.size());
+    const auto tail = m_frontier.subview_unchecked(m_frontier.size() - size);
+    m_frontier = m_frontier.subview_unchecked(0, m_frontier.size() - size);
+
+    ASAN_UNPOISON_MEMORY_REGION(tail.into_ptr().unwrap(), tail.size());
+
+    return tail;
+  }
+
+  /* Free objects are not contiguous, so give them away one at a time */
+  if (!m_front.isset() || object_size() > max_size) {
+    return View<u8>::create_empty();
+  }
+
+  const auto freenode = m_front;
+  ASAN_UNPOISON_MEMORY_REGION(freenode.unwrap(), object_size());
+
+  m_front = freenode->m_next;
+
+  return View<u8>(bit_cast<u8*>(freenode.unwrap()), object_size());
 }
 
 SYM_EXPORT auto IntrusivePool::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
   size = max(size, sizeof(FreeNode));
 
-  if (!m_front.isset() || size > object_size() || align > object_align()) [[unlikely]] {
+  if (size > object_size() || align > object_align()) [[unlikely]] {
     return nullptr;
   }
 
+  if (!m_front.isset()) {
+    const auto object = carve();
+    if (object.isset()) [[likely]] {
+      ASAN_UNPOISON_MEMORY_REGION(object.unwrap(), size);
+      assert_invariant(is_aligned_pow2(object, align));
+    }
+
+    return object.unwrap();
+  }
+
   const auto freenode = m_front;
   ASAN_UNPOISON_MEMORY_REGION(freenode.unwrap(), size);
 
@@ -69,15 +115,74 @@ SYM_EXPORT void IntrusivePool::virt_deallocate(OwnPtr<void> ptr, usize size, Pow
   ASAN_POISON_MEMORY_REGION(ptr.unwrap(), object_size());
 }
 
+SYM_EXPORT auto IntrusivePool::virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize {
+  size = max(size, sizeof(FreeNode));
+
+  if (size > object_size() || align > object_align()) [[unlikely]] {
+    return 0;
+  }
+
+  usize count = 0;
+
+  while (count < out.size() && m_front.isset()) {
+    const auto freenode = m_front;
+    ASAN_UNPOISON_MEMORY_REGION(freenode.unwrap(), size);
+
+    m_front = freenode->m_next;
+    out.set_unchecked(count++, freenode.unwrap());
+  }
+
+  while (count < out.size()) {
+    const auto object = carve();
+    if (object.is_null()) {
+      break;
+    }
+
+    ASAN_UNPOISON_MEMORY_REGION(object.unwrap(), size);
+    out.set_unchecked(count++, object.unwrap());
+  }
+
+  return count;
+}
+
+SYM_EXPORT auto IntrusivePool::virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void {
+  assert_invariant(size <= object_size() && max(align.unwrap(), alignof(FreeNode)) == object_align());
+
+  for (auto* ptr : ptrs) {
+    if (ptr == nullptr) {
+      continue;
+    }
+
+    const auto node = OwnPtr(bit_cast<FreeNode*>(ptr));
+
+    node->m_next = m_front;
+    m_front = node;
+
+    ASAN_POISON_MEMORY_REGION(ptr, object_size());
+  }
+}
+
 SYM_EXPORT auto IntrusivePool::virt_utilize(View<u8> pool) -> void {
   if (pool.empty()) [[unlikely]] {
     return;
   }
 
-  for_each_chunk_aligned(pool, object_size(), object_align(), [&](auto object_range) {
+  /* Only one region is carved lazily; keep the larger one and split the other now */
+  auto eager = pool;
+  if (m_frontier.size() < pool.size()) {
+    eager = m_frontier;
+    m_frontier = pool;
+
+    ASAN_POISON_MEMORY_REGION(pool.into_ptr().unwrap(), pool.size());
+  }
+
+  for_each_chunk_aligned(eager, object_size(), object_align(), [&](auto object_range) {
     const auto object_ptr = OwnPtr(object_range.into_ptr().get_unchecked().unwrap());
     assert_invariant(object_range.size() == object_size() && is_aligned_pow2(object_ptr, object_align()));
 
+    ASAN_UNPOISON_MEMORY_REGION(object_ptr.unwrap(), sizeof(FreeNode));
     IntrusivePool::virt_deallocate(object_ptr.unwrap(), object_size(), object_align());
   });
 }
+
+SYM_EXPORT auto IntrusivePool::virt_accepts_donations() const -> bool { return true; }
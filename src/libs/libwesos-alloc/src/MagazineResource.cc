@@ -0,0 +1,284 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-alloc/MagazineResource.hh>
+#include <wesos-builtin/Export.hh>
+
+using namespace wesos;
+using namespace wesos::mem;
+using namespace wesos::alloc;
+
+SYM_EXPORT MagazineResource::MagazineResource(MemoryResourceProtocol& inner) : m_inner(inner) {}
+
+SYM_EXPORT MagazineResource::~MagazineResource() {
+  m_caches.for_each([&](CpuCache& cache) {
+    for (usize i = 0; i < SizeClass::COUNT; i++) {
+      if (const auto loaded = cache.m_loaded.get_unchecked(i)) {
+        drain_magazine(loaded.get_unchecked(), i);
+      }
+
+      if (const auto previous = cache.m_previous.get_unchecked(i)) {
+        drain_magazine(previous.get_unchecked(), i);
+      }
+    }
+  });
+
+  drain_depot();
+}
+
+auto MagazineResource::new_magazine() -> NullableRefPtr<Magazine> {
+  const auto storage = m_inner.allocate_bytes(sizeof(Magazine), alignof(Magazine));
+  if (storage.is_null()) [[unlikely]] {
+    return null;
+  }
+
+  return ::new (storage.unwrap()) Magazine();
+}
+
+auto MagazineResource::drain_magazine(RefPtr<Magazine> magazine, usize index) -> void {
+  const auto object_size = SizeClass::size_of(index);
+  const auto object_align = SizeClass::align_of(index);
+
+  while (!magazine->is_empty()) {
+    m_inner.deallocate_bytes(magazine->m_round.get_unchecked(--magazine->m_rounds), object_size, object_align);
+  }
+
+  magazine->~Magazine();
+  m_inner.deallocate_bytes(magazine.unwrap(), sizeof(Magazine), alignof(Magazine));
+}
+
+auto MagazineResource::drain_depot() -> void {
+  for (usize i = 0; i < SizeClass::COUNT; i++) {
+    auto& depot = m_depots.get_unchecked(i);
+
+    while (const auto magazine = depot.m_full) {
+      depot.m_full = magazine->m_next;
+      drain_magazine(magazine.get_unchecked(), i);
+    }
+
+    while (const auto magazine = depot.m_empty) {
+      depot.m_empty = magazine->m_next;
+      drain_magazine(magazine.get_unchecked(), i);
+    }
+  }
+}
+
+auto MagazineResource::exchange_full(CpuCache& cache, usize index) -> bool {
+  auto& depot = m_depots.get_unchecked(index);
+  auto& loaded = cache.m_loaded.get_unchecked(index);
+  auto& previous = cache.m_previous.get_unchecked(index);
+
+  if (const auto full = depot.m_full) {
+    depot.m_full = full->m_next;
+
+    if (previous.isset()) {
+      previous->m_next = depot.m_empty;
+      depot.m_empty = previous;
+    }
+
+    previous = loaded;
+    loaded = full;
+
+    return true;
+  }
+
+  /* No full magazine to swap in; fill the loaded one in bulk from the inner resource */
+  if (loaded.is_null()) {
+    if (const auto empty = depot.m_empty) {
+      depot.m_empty = empty->m_next;
+      loaded = empty;
+    } else if (loaded = new_magazine(); loaded.is_null()) [[unlikely]] {
+      return false;
+    }
+  }
+
+  const auto object_size = SizeClass::size_of(index);
+  const auto object_align = SizeClass::align_of(index);
+
+  Array<void*, MAGAZINE_ROUNDS> batch;
+  const auto wanted = MAGAZINE_ROUNDS - loaded->m_rounds;
+  const auto count = m_inner.allocate_bulk(batch.as_view().subview_unchecked(0, wanted), object_size, object_align);
+
+  for (usize i = 0; i < count; i++) {
+    loaded->m_round.get_unchecked(loaded->m_rounds++) = batch.get_unchecked(i);
+  }
+
+  return !loaded->is_empty();
+}
+
+auto MagazineResource::exchange_empty(CpuCache& cache, usize index) -> bool {
+  auto& depot = m_depots.get_unchecked(index);
+  auto& loaded = cache.m_loaded.get_unchecked(index);
+  auto& previous = cache.m_previous.get_unchecked(index);
+
+  if (previous.isset()) {
+    assert_invariant(previous->is_full());
+    previous->m_next = depot.m_full;
+    depot.m_full = previous;
+  }
+
+  previous = loaded;
+
+  if (const auto empty = depot.m_empty) {
+    depot.m_empty = empty->m_next;
+    loaded = empty;
+  } else {
+    loaded = new_magazine();
+  }
+
+  return loaded.isset();
+}
+
+SYM_EXPORT auto MagazineResource::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  const auto index = SizeClass::index_of(size, align);
+  if (index.is_null()) [[unlikely]] {
+    return m_depot_lock.critical_section([&] { return m_inner.allocate_bytes(size, align); });
+  }
+
+  const auto class_index = index.value_unchecked();
+  auto& cache = m_caches.local();
+
+  return cache.m_lock.critical_section([&]() -> NullableOwnPtr<void> {
+    auto& loaded = cache.m_loaded.get_unchecked(class_index);
+    auto& previous = cache.m_previous.get_unchecked(class_index);
+
+    if (loaded.is_null() || loaded->is_empty()) [[unlikely]] {
+      if (previous.isset() && !previous->is_empty()) {
+        const auto tmp = loaded;
+        loaded = previous;
+        previous = tmp;
+      } else if (!m_depot_lock.critical_section([&] { return exchange_full(cache, class_index); })) [[unlikely]] {
+        return null;
+      }
+    }
+
+    return loaded->m_round.get_unchecked(--loaded->m_rounds);
+  });
+}
+
+SYM_EXPORT void MagazineResource::virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) {
+  const auto index = SizeClass::index_of(size, align);
+  if (index.is_null()) [[unlikely]] {
+    return m_depot_lock.critical_section([&] { m_inner.deallocate_bytes(ptr, size, align); });
+  }
+
+  const auto class_index = index.value_unchecked();
+  auto& cache = m_caches.local();
+
+  const auto cached = cache.m_lock.critical_section([&] {
+    auto& loaded = cache.m_loaded.get_unchecked(class_index);
+    auto& previous = cache.m_previous.get_unchecked(class_index);
+
+    if (loaded.is_null() || loaded->is_full()) [[unlikely]] {
+      if (previous.isset() && !previous->is_full()) {
+        const auto tmp = loaded;
+        loaded = previous;
+        previous = tmp;
+      } else if (!m_depot_lock.critical_section([&] { return exchange_empty(cache, class_index); })) [[unlikely]] {
+        return false;
+      }
+    }
+
+    loaded->m_round.get_unchecked(loaded->m_rounds++) = ptr;
+    return true;
+  });
+
+  if (!cached) [[unlikely]] {
+    const auto object_size = SizeClass::size_of(class_index);
+    const auto object_align = SizeClass::align_of(class_index);
+    m_depot_lock.critical_section([&] { m_inner.deallocate_bytes(ptr, object_size, object_align); });
+  }
+}
+
+SYM_EXPORT auto MagazineResource::virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize {
+  const auto index = SizeClass::index_of(size, align);
+  if (index.is_null()) [[unlikely]] {
+    return m_depot_lock.critical_section([&] { return m_inner.allocate_bulk(out, size, align); });
+  }
+
+  const auto class_index = index.value_unchecked();
+  auto& cache = m_caches.local();
+
+  return cache.m_lock.critical_section([&] {
+    auto& loaded = cache.m_loaded.get_unchecked(class_index);
+    auto& previous = cache.m_previous.get_unchecked(class_index);
+    usize count = 0;
+
+    while (count < out.size()) {
+      if (loaded.is_null() || loaded->is_empty()) {
+        if (previous.isset() && !previous->is_empty()) {
+          const auto tmp = loaded;
+          loaded = previous;
+          previous = tmp;
+        } else if (!m_depot_lock.critical_section([&] { return exchange_full(cache, class_index); })) [[unlikely]] {
+          break;
+        }
+      }
+
+      while (count < out.size() && !loaded->is_empty()) {
+        out.set_unchecked(count++, loaded->m_round.get_unchecked(--loaded->m_rounds).unwrap());
+      }
+    }
+
+    return count;
+  });
+}
+
+SYM_EXPORT auto MagazineResource::virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void {
+  const auto index = SizeClass::index_of(size, align);
+  if (index.is_null()) [[unlikely]] {
+    return m_depot_lock.critical_section([&] { m_inner.deallocate_bulk(ptrs, size, align); });
+  }
+
+  const auto class_index = index.value_unchecked();
+  auto& cache = m_caches.local();
+
+  const auto cached = cache.m_lock.critical_section([&] {
+    auto& loaded = cache.m_loaded.get_unchecked(class_index);
+    auto& previous = cache.m_previous.get_unchecked(class_index);
+    usize count = 0;
+
+    while (count < ptrs.size()) {
+      if (loaded.is_null() || loaded->is_full()) {
+        if (previous.isset() && !previous->is_full()) {
+          const auto tmp = loaded;
+          loaded = previous;
+          previous = tmp;
+        } else if (!m_depot_lock.critical_section([&] { return exchange_empty(cache, class_index); })) [[unlikely]] {
+          break;
+        }
+      }
+
+      while (count < ptrs.size() && !loaded->is_full()) {
+        if (auto* ptr = ptrs.get_unchecked(count++)) {
+          loaded->m_round.get_unchecked(loaded->m_rounds++) = ptr;
+        }
+      }
+    }
+
+    return count;
+  });
+
+  if (cached != ptrs.size()) [[unlikely]] {
+    const auto object_size = SizeClass::size_of(class_index);
+    const auto object_align = SizeClass::align_of(class_index);
+    m_depot_lock.critical_section(
+        [&] { m_inner.deallocate_bulk(ptrs.subview_unchecked(cached), object_size, object_align); });
+  }
+}
+
+SYM_EXPORT auto MagazineResource::virt_utilize(View<u8> pool) -> void {
+  m_depot_lock.critical_section([&] { m_inner.utilize_bytes(pool); });
+}
+
+SYM_EXPORT auto MagazineResource::virt_embezzle(usize max_size) -> View<u8> {
+  /* Idle blocks parked in the depot are the inner resource's to give away */
+  return m_depot_lock.critical_section([&] {
+    drain_depot();
+    return m_inner.embezzle_bytes(max_size);
+  });
+}
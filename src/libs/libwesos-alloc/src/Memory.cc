@@ -0,0 +1,52 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-alloc/TieredResource.hh>
+#include <wesos-builtin/Export.hh>
+#include <wesos-mem/Memory.hh>
+#include <wesos-sync/Atomic.hh>
+
+namespace {
+  /* Constructs the value in place and never destroys it */
+  template <class T>
+  union Immortal {
+    T m_value;
+
+    template <class... Args>
+    Immortal(Args &&...args) : m_value(wesos::forward<Args>(args)...) {}
+    ~Immortal() {}
+  };
+}  // namespace
+
+SYM_EXPORT auto wesos::mem::get_default_resource() -> MemoryResourceProtocol & {
+  /*
+   * The memory behind the default resource belongs to whoever called initialize()
+   * and may already be gone at exit, so tearing the resource down is never safe.
+   */
+  static Immortal<alloc::TieredResource> TIERED_RESOURCE_STATIC;
+
+  static Immortal<AtomicResource> ATOMIC_RESOURCE_STATIC(TIERED_RESOURCE_STATIC.m_value);
+
+  return ATOMIC_RESOURCE_STATIC.m_value;
+}
+
+SYM_EXPORT auto wesos::mem::initialize(Kickstart initial_buffer) -> bool {
+  static sync::Atomic<bool> INITIALIZED_STATIC = false;
+
+  /* The default resource keeps the buffer forever, so a second one could never be detached again */
+  bool expected = false;
+  if (!INITIALIZED_STATIC.compare_exchange_strong(expected, true)) {
+    return false;
+  }
+
+  const auto view = View<u8>(initial_buffer.m_buffer_ptr, initial_buffer.m_buffer_size.unwrap());
+
+  auto &default_resource = get_default_resource();
+  default_resource.utilize_bytes(view);
+
+  return true;
+}
@@ -0,0 +1,98 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-alloc/MonotonicArena.hh>
+#include <wesos-builtin/Export.hh>
+
+using namespace wesos;
+using namespace wesos::mem;
+using namespace wesos::alloc;
+
+SYM_EXPORT MonotonicArena::MonotonicArena(MemoryResourceProtocol& upstream, usize initial_chunk_size)
+    : m_upstream(upstream),
+      m_initial_chunk_size(max(initial_chunk_size, sizeof(Chunk))),
+      m_next_chunk_size(m_initial_chunk_size) {}
+
+SYM_EXPORT MonotonicArena::~MonotonicArena() { reset(); }
+
+SYM_EXPORT auto MonotonicArena::reset() -> void {
+  while (m_chunks.isset()) {
+    const auto chunk = m_chunks.get_unchecked();
+    const auto size = chunk->m_size;
+    m_chunks = chunk->m_next;
+
+    chunk->~Chunk();
+    m_upstream.deallocate_bytes(chunk.unwrap(), size, alignof(Chunk));
+  }
+
+  m_cursor = 0;
+  m_end = 0;
+  m_next_chunk_size = m_initial_chunk_size;
+}
+
+auto MonotonicArena::grow(usize size, PowerOfTwo<usize> align) -> bool {
+  /* Worst case the payload starts (align - 1) bytes past the chunk header */
+  usize needed = 0;
+  if (__builtin_add_overflow(size, sizeof(Chunk) + align.unwrap() - 1, &needed)) [[unlikely]] {
+    return false;
+  }
+
+  const auto chunk_size = max(m_next_chunk_size, needed);
+
+  const auto storage = m_upstream.allocate_bytes(chunk_size, alignof(Chunk));
+  if (storage.is_null()) [[unlikely]] {
+    return false;
+  }
+
+  const auto chunk = ::new (storage.unwrap()) Chunk(m_chunks, chunk_size);
+  m_chunks = chunk;
+
+  m_cursor = bit_cast<uptr>(chunk) + sizeof(Chunk);
+  m_end = bit_cast<uptr>(chunk) + chunk_size;
+  m_next_chunk_size = min(m_next_chunk_size * 2, MAX_CHUNK_SIZE);
+
+  return true;
+}
+
+SYM_EXPORT auto MonotonicArena::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  auto start = (m_cursor + align.unwrap() - 1) & ~(align.unwrap() - 1);
+
+  if (m_cursor == 0 || start > m_end || size > m_end - start) [[unlikely]] {
+    if (!grow(size, align)) [[unlikely]] {
+      return null;
+    }
+
+    start = (m_cursor + align.unwrap() - 1) & ~(align.unwrap() - 1);
+  }
+
+  m_cursor = start + size;
+
+  return bit_cast<void*>(start);
+}
+
+SYM_EXPORT void MonotonicArena::virt_deallocate(OwnPtr<void>, usize, PowerOfTwo<usize>) {
+  /* Memory is only reclaimed by reset() */
+}
+
+SYM_EXPORT auto MonotonicArena::virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize {
+  usize count = 0;
+
+  for (; count < out.size(); count++) {
+    const auto ptr = MonotonicArena::virt_allocate(size, align);
+    if (ptr.is_null()) [[unlikely]] {
+      break;
+    }
+
+    out.set_unchecked(count, ptr.unwrap());
+  }
+
+  return count;
+}
+
+SYM_EXPORT void MonotonicArena::virt_deallocate_bulk(View<void*>, usize, PowerOfTwo<usize>) {
+  /* Memory is only reclaimed by reset() */
+}
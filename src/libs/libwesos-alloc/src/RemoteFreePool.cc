@@ -0,0 +1,170 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#if __SANITIZE_ADDRESS__ || (defined(__has_feature) && __has_feature(address_sanitizer))
+#include <sanitizer/asan_interface.h>
+#elif !defined(__SANITIZE_ADDRESS__)
+// #warning "Building memory allocator without address -fsanitize=address enabled"
+
+#define ASAN_POISON_MEMORY_REGION(addr, size) ((void)(addr), (void)(size))
+#define ASAN_UNPOISON_MEMORY_REGION(addr, size) ((void)(addr), (void)(size))
+#endif
+
+#include <wesos-alloc/RemoteFreePool.hh>
+#include <wesos-builtin/Export.hh>
+
+using namespace wesos;
+using namespace wesos::mem;
+using namespace wesos::alloc;
+
+SYM_EXPORT RemoteFreePool::RemoteFreePool(ObjectSize object_size, PowerOfTwo<usize> object_align, View<u8> pool)
+    : m_object_size(object_size), m_object_align(max(object_align.unwrap(), alignof(FreeNode))), m_remote(nullptr) {
+  RemoteFreePool::virt_utilize(pool);
+}
+
+auto RemoteFreePool::push_remote(RefPtr<FreeNode> first, RefPtr<FreeNode> last) -> void {
+  auto head = m_remote.load(sync::memory_order_relaxed);
+
+  do {
+    last->m_next = head;
+  } while (!m_remote.compare_exchange_weak(head, first.unwrap(), sync::memory_order_release,
+                                           sync::memory_order_relaxed));
+}
+
+auto RemoteFreePool::reclaim() -> bool {
+  /* Taking the whole list at once needs no ABA protection */
+  m_local = m_remote.exchange(nullptr, sync::memory_order_acquire);
+  return m_local.isset();
+}
+
+SYM_EXPORT auto RemoteFreePool::virt_embezzle(usize max_size) -> View<u8> {
+  /* The private list belongs to the owner, which may be allocating right now */
+  if (object_size() > max_size) {
+    return View<u8>::create_empty();
+  }
+
+  auto* taken = m_remote.exchange(nullptr, sync::memory_order_acquire);
+  if (taken == nullptr) {
+    return View<u8>::create_empty();
+  }
+
+  if (auto* rest = taken->m_next; rest != nullptr) {
+    auto* last = rest;
+    while (last->m_next != nullptr) {
+      last = last->m_next;
+    }
+
+    push_remote(rest, last);
+  }
+
+  ASAN_UNPOISON_MEMORY_REGION(taken, object_size());
+
+  return View<u8>(bit_cast<u8*>(taken), object_size());
+}
+
+SYM_EXPORT auto RemoteFreePool::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  size = max(size, sizeof(FreeNode));
+
+  if (size > object_size() || align > object_align()) [[unlikely]] {
+    return nullptr;
+  }
+
+  if (m_local.is_null() && !reclaim()) [[unlikely]] {
+    return nullptr;
+  }
+
+  const auto freenode = m_local;
+  ASAN_UNPOISON_MEMORY_REGION(freenode.unwrap(), size);
+
+  m_local = freenode->m_next;
+
+  const auto result = OwnPtr(bit_cast<u8*>(freenode.unwrap()));
+  assert_invariant(is_aligned_pow2(result, align));
+
+  return result.unwrap();
+}
+
+SYM_EXPORT void RemoteFreePool::virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) {
+  assert_invariant(size <= object_size() && max(align.unwrap(), alignof(FreeNode)) == object_align());
+
+  const auto node = OwnPtr(bit_cast<FreeNode*>(ptr.unwrap()));
+
+  /* The link stays unpoisoned; it is written here and read by the owner */
+  ASAN_POISON_MEMORY_REGION(bit_cast<u8*>(ptr.unwrap()) + sizeof(FreeNode), object_size() - sizeof(FreeNode));
+
+  push_remote(node, node);
+}
+
+SYM_EXPORT auto RemoteFreePool::virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize {
+  size = max(size, sizeof(FreeNode));
+
+  if (size > object_size() || align > object_align()) [[unlikely]] {
+    return 0;
+  }
+
+  usize count = 0;
+
+  while (count < out.size()) {
+    if (m_local.is_null() && !reclaim()) {
+      break;
+    }
+
+    const auto freenode = m_local;
+    ASAN_UNPOISON_MEMORY_REGION(freenode.unwrap(), size);
+
+    m_local = freenode->m_next;
+    out.set_unchecked(count++, freenode.unwrap());
+  }
+
+  return count;
+}
+
+SYM_EXPORT auto RemoteFreePool::virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void {
+  assert_invariant(size <= object_size() && max(align.unwrap(), alignof(FreeNode)) == object_align());
+
+  /* Link the batch privately, then publish it with a single CAS */
+  NullableRefPtr<FreeNode> first;
+  NullableRefPtr<FreeNode> last;
+
+  for (auto* ptr : ptrs) {
+    if (ptr == nullptr) {
+      continue;
+    }
+
+    const auto node = bit_cast<FreeNode*>(ptr);
+    node->m_next = first.unwrap();
+    ASAN_POISON_MEMORY_REGION(bit_cast<u8*>(ptr) + sizeof(FreeNode), object_size() - sizeof(FreeNode));
+
+    if (last.is_null()) {
+      last = node;
+    }
+    first = node;
+  }
+
+  if (first.isset()) {
+    push_remote(first.get_unchecked(), last.get_unchecked());
+  }
+}
+
+SYM_EXPORT auto RemoteFreePool::virt_utilize(View<u8> pool) -> void {
+  if (pool.empty()) [[unlikely]] {
+    return;
+  }
+
+  for_each_chunk_aligned(pool, object_size(), object_align(), [&](auto object_range) {
+    const auto object_ptr = OwnPtr(object_range.into_ptr().get_unchecked().unwrap());
+    assert_invariant(object_range.size() == object_size() && is_aligned_pow2(object_ptr, object_align()));
+
+    const auto node = ::new (object_ptr.unwrap()) FreeNode();
+    node->m_next = m_local.unwrap();
+    m_local = node;
+
+    ASAN_POISON_MEMORY_REGION(object_ptr.unwrap() + sizeof(FreeNode), object_size() - sizeof(FreeNode));
+  });
+}
+
+SYM_EXPORT auto RemoteFreePool::virt_accepts_donations() const -> bool { return true; }
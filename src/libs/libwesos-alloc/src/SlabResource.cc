@@ -0,0 +1,129 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-alloc/SlabResource.hh>
+#include <wesos-builtin/Export.hh>
+
+using namespace wesos;
+using namespace wesos::mem;
+using namespace wesos::alloc;
+
+SYM_EXPORT SlabResource::SlabResource(MemoryResourceProtocol& backing, usize min_slab_size)
+    : m_backing(backing), m_min_slab_size(min_slab_size) {
+  for (usize i = 0; i < SizeClass::COUNT; i++) {
+    ::new (&pool(i)) IntrusivePool(SizeClass::size_of(i), SizeClass::align_of(i));
+  }
+}
+
+SYM_EXPORT SlabResource::~SlabResource() {
+  /* The pools must go first; they still reference memory inside the slabs */
+  for (usize i = 0; i < SizeClass::COUNT; i++) {
+    pool(i).~IntrusivePool();
+  }
+
+  while (m_slabs.isset()) {
+    const auto slab = m_slabs.get_unchecked();
+    const auto size = slab->m_size;
+    const auto align = slab->m_align;
+    m_slabs = slab->m_next;
+
+    slab->~Slab();
+    m_backing.deallocate_bytes(slab.unwrap(), size, align);
+  }
+}
+
+auto SlabResource::pool(usize index) -> IntrusivePool& {
+  assert_invariant(index < SizeClass::COUNT);
+  return *bit_cast<IntrusivePool*>(m_pools.into_ptr().add(index * sizeof(IntrusivePool)).unwrap());
+}
+
+auto SlabResource::refill(usize index) -> bool {
+  const auto size = slab_size(index);
+  const auto align = PowerOfTwo<usize>::create_unchecked(max(SizeClass::align_of(index).unwrap(), alignof(Slab)));
+
+  const auto storage = m_backing.allocate_bytes(size, align);
+  if (storage.is_null()) [[unlikely]] {
+    return false;
+  }
+
+  const auto slab = OwnPtr(::new (storage.unwrap()) Slab(m_slabs, size, align));
+  m_slabs = slab;
+
+  const auto base = slab.bitcast_to<u8>();
+  pool(index).utilize_bytes(View<u8>(base.add(sizeof(Slab)), base.add(size)));
+
+  return true;
+}
+
+SYM_EXPORT auto SlabResource::virt_embezzle(usize max_size) -> View<u8> {
+  // The slabs are owned by the pools; only the backing resource has idle memory.
+  return m_backing.embezzle_bytes(max_size);
+}
+
+SYM_EXPORT auto SlabResource::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  const auto index = SizeClass::index_of(size, align);
+  if (index.is_null()) [[unlikely]] {
+    return m_backing.allocate_bytes(size, align);
+  }
+
+  const auto class_index = index.value_unchecked();
+  const auto object_size = SizeClass::size_of(class_index);
+  const auto object_align = SizeClass::align_of(class_index);
+  auto& the_pool = pool(class_index);
+
+  if (auto ptr = the_pool.allocate_bytes(object_size, object_align)) [[likely]] {
+    return ptr;
+  }
+
+  if (!refill(class_index)) [[unlikely]] {
+    return null;
+  }
+
+  return the_pool.allocate_bytes(object_size, object_align);
+}
+
+SYM_EXPORT void SlabResource::virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) {
+  const auto index = SizeClass::index_of(size, align);
+  if (index.is_null()) [[unlikely]] {
+    return m_backing.deallocate_bytes(ptr, size, align);
+  }
+
+  const auto class_index = index.value_unchecked();
+  pool(class_index).deallocate_bytes(ptr, SizeClass::size_of(class_index), SizeClass::align_of(class_index));
+}
+
+SYM_EXPORT auto SlabResource::virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize {
+  const auto index = SizeClass::index_of(size, align);
+  if (index.is_null()) [[unlikely]] {
+    return m_backing.allocate_bulk(out, size, align);
+  }
+
+  const auto class_index = index.value_unchecked();
+  const auto object_size = SizeClass::size_of(class_index);
+  const auto object_align = SizeClass::align_of(class_index);
+  auto& the_pool = pool(class_index);
+
+  auto count = the_pool.allocate_bulk(out, object_size, object_align);
+
+  while (count < out.size() && refill(class_index)) {
+    count += the_pool.allocate_bulk(out.subview_unchecked(count), object_size, object_align);
+  }
+
+  return count;
+}
+
+SYM_EXPORT auto SlabResource::virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void {
+  const auto index = SizeClass::index_of(size, align);
+  if (index.is_null()) [[unlikely]] {
+    return m_backing.deallocate_bulk(ptrs, size, align);
+  }
+
+  const auto class_index = index.value_unchecked();
+  pool(class_index).deallocate_bulk(ptrs, SizeClass::size_of(class_index), SizeClass::align_of(class_index));
+}
+
+SYM_EXPORT auto SlabResource::virt_utilize(View<u8> pool) -> void { m_backing.utilize_bytes(pool); }
@@ -0,0 +1,102 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-alloc/TieredResource.hh>
+#include <wesos-builtin/Export.hh>
+
+using namespace wesos;
+using namespace wesos::mem;
+using namespace wesos::alloc;
+
+SYM_EXPORT TieredResource::TieredResource(View<u8> pool) : m_slabs(m_general, BOOTSTRAP_SLAB_SIZE) {
+  TieredResource::virt_utilize(pool);
+}
+
+auto TieredResource::grow_general(usize size, PowerOfTwo<usize> align) -> bool {
+  /* Leave room for the free list's boundary tags and any alignment padding */
+  const auto needed = size + align.unwrap() + BuddyResource::PAGE_SIZE;
+
+  auto grow_size = GENERAL_GROW_SIZE;
+  while (grow_size < needed) {
+    grow_size *= 2;
+  }
+
+  const auto storage = m_pages.allocate_bytes(grow_size, BuddyResource::PAGE_SIZE);
+  if (storage.is_null()) [[unlikely]] {
+    return false;
+  }
+
+  /*
+   * The span is an allocated buddy block, so its first byte is a page `m_pages.owns`.
+   * Keep that byte out of the free list; then no block from `m_general` can start
+   * there, and deallocation can tell the two origins apart by address alone.
+   */
+  const auto span = View<u8>(static_cast<u8*>(storage.unwrap()), grow_size);
+  m_general.utilize_bytes(span.subview_unchecked(SPAN_GUARD_SIZE));
+
+  return true;
+}
+
+auto TieredResource::allocate_large(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  if (auto ptr = m_pages.allocate_bytes(size, align)) [[likely]] {
+    return ptr;
+  }
+
+  /* Too early for the buddy tier (or too fragmented); the free list may still fit it */
+  return m_general.allocate_bytes(size, align);
+}
+
+SYM_EXPORT auto TieredResource::virt_embezzle(usize max_size) -> View<u8> {
+  if (auto pages = m_pages.embezzle_bytes(max_size); !pages.empty()) {
+    return pages;
+  }
+
+  return m_general.embezzle_bytes(max_size);
+}
+
+SYM_EXPORT auto TieredResource::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  const auto index = SizeClass::index_of(size, align);
+  if (index.is_null()) [[unlikely]] {
+    return allocate_large(size, align);
+  }
+
+  if (auto ptr = m_slabs.allocate_bytes(size, align)) [[likely]] {
+    return ptr;
+  }
+
+  /* The free list could not fit another slab; move some pages over and retry */
+  const auto class_index = index.value_unchecked();
+  if (!grow_general(m_slabs.slab_size(class_index), SizeClass::align_of(class_index))) [[unlikely]] {
+    return null;
+  }
+
+  return m_slabs.allocate_bytes(size, align);
+}
+
+SYM_EXPORT void TieredResource::virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) {
+  if (SizeClass::index_of(size, align).isset()) [[likely]] {
+    return m_slabs.deallocate_bytes(ptr, size, align);
+  }
+
+  /* Only blocks the buddy tier handed out start on one of its allocated pages */
+  if (m_pages.owns(ptr.unwrap())) {
+    return m_pages.deallocate_bytes(ptr, size, align);
+  }
+
+  /* Either `allocate_large` fell back to the free list, or it came from a small pool */
+  m_general.deallocate_bytes(ptr, size, align);
+}
+
+SYM_EXPORT auto TieredResource::virt_utilize(View<u8> pool) -> void {
+  if (pool.size() >= PAGE_POOL_MIN_SIZE) {
+    m_pages.utilize_bytes(pool);
+  } else {
+    m_general.utilize_bytes(pool);
+  }
+}
+
+SYM_EXPORT auto TieredResource::virt_accepts_donations() const -> bool { return true; }
@@ -0,0 +1,196 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <wesos-alloc/AtomicIntrusivePool.hh>
+
+using namespace wesos;
+
+namespace {
+  void deps_setup() {
+    wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+      std::cerr << "\n==========================================================================="
+                   "===========\n"
+                << "| Assertion Failed: \"" << message << "\";\n"
+                << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+                << "| File: \"" << source.file_name() << "\";\n"
+                << "============================================================================="
+                   "=========\n"
+                << std::endl;
+    });
+  }
+}  // namespace
+
+TEST(wesos_alloc, AtomicIntrusivePool_Allocate) {
+  deps_setup();
+
+  constexpr usize object_size = 48;
+  constexpr usize object_align = 16;
+  constexpr usize object_count = 64;
+
+  alignas(object_align) Array<u8, object_size * object_count> storage;
+  auto mm = alloc::AtomicIntrusivePool(object_size, object_align, storage.as_view());
+
+  std::unordered_set<void*> pointers;
+
+  for (usize i = 0; i < object_count; i++) {
+    auto ptr = mm.allocate_bytes(object_size, object_align);
+
+    ASSERT_TRUE(ptr.isset());
+    ASSERT_TRUE(is_aligned_pow2(ptr, object_align));
+    ASSERT_FALSE(pointers.contains(ptr.unwrap()));
+
+    memset(ptr.unwrap(), 0, object_size);
+    pointers.insert(ptr.unwrap());
+  }
+
+  ASSERT_FALSE(mm.allocate_bytes(object_size, object_align).isset());
+  ASSERT_FALSE(mm.allocate_bytes(object_size + 1, object_align).isset());
+
+  for (auto* ptr : pointers) {
+    mm.deallocate_bytes(ptr, object_size, object_align);
+  }
+
+  auto expected_objects = pointers;
+  pointers.clear();
+
+  for (usize i = 0; i < object_count; i++) {
+    auto ptr = mm.allocate_bytes(object_size, object_align);
+    ASSERT_TRUE(ptr.isset());
+    pointers.insert(ptr.unwrap());
+  }
+
+  ASSERT_EQ(pointers, expected_objects);
+}
+
+TEST(wesos_alloc, AtomicIntrusivePool_Threads) {
+  deps_setup();
+
+  constexpr usize thread_count = 8;
+  constexpr usize objects_per_thread = 16;
+  constexpr usize rounds = 20000;
+  constexpr usize object_size = 32;
+
+  std::vector<u64> storage(thread_count * objects_per_thread * object_size / sizeof(u64));
+  auto mm = alloc::AtomicIntrusivePool(object_size, alignof(u64),
+                                       View<u8>(bit_cast<u8*>(storage.data()), storage.size() * sizeof(u64)));
+
+  std::vector<std::thread> threads;
+  std::vector<int> ok(thread_count, 1);
+
+  for (usize t = 0; t < thread_count; t++) {
+    threads.emplace_back([&, t] {
+      std::vector<u64*> held;
+
+      for (usize round = 0; round < rounds; round++) {
+        const auto want = 1 + (round % objects_per_thread);
+
+        while (held.size() < want) {
+          auto ptr = mm.allocate_bytes(object_size, alignof(u64));
+          if (ptr.is_null()) {
+            ok[t] = 0;
+            return;
+          }
+
+          auto* object = static_cast<u64*>(ptr.unwrap());
+          for (usize i = 0; i < object_size / sizeof(u64); i++) {
+            object[i] = t;
+          }
+
+          held.push_back(object);
+        }
+
+        for (auto* object : held) {
+          for (usize i = 0; i < object_size / sizeof(u64); i++) {
+            if (object[i] != t) {
+              ok[t] = 0;
+            }
+          }
+
+          mm.deallocate_bytes(object, object_size, alignof(u64));
+        }
+
+        held.clear();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (usize t = 0; t < thread_count; t++) {
+    ASSERT_TRUE(ok[t]) << "Thread " << t << " got a block that was in use";
+  }
+}
+
+TEST(wesos_alloc, AtomicIntrusivePool_BulkThreads) {
+  deps_setup();
+
+  constexpr usize thread_count = 8;
+  constexpr usize batch_size = 12;
+  constexpr usize rounds = 20000;
+  constexpr usize object_size = 32;
+
+  std::vector<u64> storage(thread_count * batch_size * object_size / sizeof(u64));
+  auto mm = alloc::AtomicIntrusivePool(object_size, alignof(u64),
+                                       View<u8>(bit_cast<u8*>(storage.data()), storage.size() * sizeof(u64)));
+
+  std::vector<std::thread> threads;
+  std::vector<int> ok(thread_count, 1);
+
+  for (usize t = 0; t < thread_count; t++) {
+    threads.emplace_back([&, t] {
+      Array<void*, batch_size> batch;
+
+      for (usize round = 0; round < rounds; round++) {
+        const auto want = 1 + (round % batch_size);
+        auto view = batch.as_view().subview(0, want);
+
+        if (mm.allocate_bulk(view, object_size, alignof(u64)) != want) {
+          ok[t] = 0;
+          return;
+        }
+
+        for (auto* ptr : view) {
+          auto* object = static_cast<u64*>(ptr);
+          for (usize i = 0; i < object_size / sizeof(u64); i++) {
+            object[i] = t;
+          }
+        }
+
+        for (auto* ptr : view) {
+          auto* object = static_cast<u64*>(ptr);
+          for (usize i = 0; i < object_size / sizeof(u64); i++) {
+            if (object[i] != t) {
+              ok[t] = 0;
+            }
+          }
+        }
+
+        mm.deallocate_bulk(view, object_size, alignof(u64));
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (usize t = 0; t < thread_count; t++) {
+    ASSERT_TRUE(ok[t]) << "Thread " << t << " got a block that was in use";
+  }
+
+  Array<void*, thread_count * batch_size + 1> all;
+  ASSERT_EQ(mm.allocate_bulk(all.as_view(), object_size, alignof(u64)), thread_count * batch_size);
+}
@@ -0,0 +1,159 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+#include <wesos-alloc/BuddyResource.hh>
+
+using namespace wesos;
+
+namespace {
+  constexpr usize POOL_SIZE = 16 * 1024 * 1024;
+
+  void deps_setup() {
+    wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+      std::cerr << "\n==========================================================================="
+                   "===========\n"
+                << "| Assertion Failed: \"" << message << "\";\n"
+                << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+                << "| File: \"" << source.file_name() << "\";\n"
+                << "============================================================================="
+                   "=========\n"
+                << std::endl;
+    });
+  }
+}  // namespace
+
+TEST(wesos_alloc, BuddyResource_OrderOf) {
+  deps_setup();
+
+  using alloc::BuddyResource;
+
+  ASSERT_EQ(BuddyResource::order_of(0, 1).value(), 0);
+  ASSERT_EQ(BuddyResource::order_of(4096, 8).value(), 0);
+  ASSERT_EQ(BuddyResource::order_of(4097, 8).value(), 1);
+  ASSERT_EQ(BuddyResource::order_of(4096, 2 * 1024 * 1024).value(), 9);
+  ASSERT_EQ(BuddyResource::order_of(BuddyResource::MAX_BLOCK_SIZE, 4096).value(), BuddyResource::MAX_ORDER);
+  ASSERT_FALSE(BuddyResource::order_of(BuddyResource::MAX_BLOCK_SIZE + 1, 4096).isset());
+}
+
+TEST(wesos_alloc, BuddyResource_SplitAndMerge) {
+  deps_setup();
+
+  auto* storage = static_cast<u8*>(std::aligned_alloc(POOL_SIZE, POOL_SIZE));
+  ASSERT_NE(storage, nullptr);
+
+  {
+    auto mm = alloc::BuddyResource(View<u8>(storage, POOL_SIZE));
+    const auto initial_free = mm.free_bytes();
+
+    ASSERT_GT(initial_free, POOL_SIZE / 2);
+    ASSERT_FALSE(mm.owns(storage + POOL_SIZE - alloc::BuddyResource::PAGE_SIZE));
+    ASSERT_FALSE(mm.owns(storage + POOL_SIZE));
+
+    struct Allocation {
+      void* m_ptr;
+      usize m_size;
+      usize m_align;
+    };
+
+    std::vector<Allocation> allocations;
+    std::unordered_set<void*> pointers;
+
+    for (usize pages = 1; pages <= 64; pages++) {
+      const usize size = pages * alloc::BuddyResource::PAGE_SIZE;
+      const usize align = pages % 3 == 0 ? 64 * 1024 : 4096;
+
+      auto ptr = mm.allocate_bytes(size, align);
+      ASSERT_TRUE(ptr.isset()) << "Failed on pages(" << pages << ")";
+      ASSERT_TRUE(is_aligned_pow2(ptr, align));
+      ASSERT_TRUE(mm.owns(ptr.unwrap()));
+      ASSERT_FALSE(pointers.contains(ptr.unwrap()));
+
+      memset(ptr.unwrap(), 0x5a, size);
+
+      pointers.insert(ptr.unwrap());
+      allocations.push_back({ptr.unwrap(), size, align});
+    }
+
+    ASSERT_LT(mm.free_bytes(), initial_free);
+
+    // Free in an interleaved order so merges happen from both sides
+    for (usize i = 0; i < allocations.size(); i += 2) {
+      mm.deallocate_bytes(allocations[i].m_ptr, allocations[i].m_size, allocations[i].m_align);
+    }
+    for (usize i = 1; i < allocations.size(); i += 2) {
+      mm.deallocate_bytes(allocations[i].m_ptr, allocations[i].m_size, allocations[i].m_align);
+    }
+
+    ASSERT_EQ(mm.free_bytes(), initial_free);
+    ASSERT_FALSE(mm.owns(allocations.front().m_ptr));
+
+    // Everything coalesced back: the largest block fits again
+    auto big = mm.allocate_bytes(POOL_SIZE / 2, POOL_SIZE / 2);
+    ASSERT_TRUE(big.isset());
+    mm.deallocate_bytes(big, POOL_SIZE / 2, POOL_SIZE / 2);
+  }
+
+  std::free(storage);
+}
+
+TEST(wesos_alloc, BuddyResource_Exhaustion) {
+  deps_setup();
+
+  auto* storage = static_cast<u8*>(std::aligned_alloc(POOL_SIZE, POOL_SIZE));
+  ASSERT_NE(storage, nullptr);
+
+  {
+    auto mm = alloc::BuddyResource(View<u8>(storage, POOL_SIZE));
+    const auto initial_free = mm.free_bytes();
+
+    std::vector<void*> pages;
+    while (auto ptr = mm.allocate_bytes(4096, 4096)) {
+      pages.push_back(ptr.unwrap());
+    }
+
+    ASSERT_EQ(mm.free_bytes(), 0);
+    ASSERT_EQ(pages.size() * 4096, initial_free);
+
+    for (auto* page : pages) {
+      mm.deallocate_bytes(page, 4096, 4096);
+    }
+
+    ASSERT_EQ(mm.free_bytes(), initial_free);
+    ASSERT_TRUE(mm.allocate_bytes(POOL_SIZE / 2, 4096).isset());
+  }
+
+  std::free(storage);
+}
+
+TEST(wesos_alloc, BuddyResource_Embezzle) {
+  deps_setup();
+
+  auto* storage = static_cast<u8*>(std::aligned_alloc(POOL_SIZE, POOL_SIZE));
+  ASSERT_NE(storage, nullptr);
+
+  {
+    auto mm = alloc::BuddyResource(View<u8>(storage, POOL_SIZE));
+    const auto initial_free = mm.free_bytes();
+
+    auto taken = mm.embezzle_bytes(1024 * 1024);
+    ASSERT_EQ(taken.size(), 1024 * 1024);
+    ASSERT_TRUE(is_aligned_pow2(taken.into_ptr(), 1024 * 1024));
+    ASSERT_EQ(mm.free_bytes(), initial_free - taken.size());
+    ASSERT_FALSE(mm.owns(taken.into_ptr().unwrap()));
+
+    ASSERT_TRUE(mm.embezzle_bytes(100).empty());
+  }
+
+  std::free(storage);
+}
@@ -0,0 +1,142 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <wesos-alloc/FreeList.hh>
+
+using namespace wesos;
+
+namespace {
+  constexpr usize POOL_SIZE = 4 * 1024 * 1024;
+
+  void deps_setup() {
+    wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+      std::cerr << "\n==========================================================================="
+                   "===========\n"
+                << "| Assertion Failed: \"" << message << "\";\n"
+                << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+                << "| File: \"" << source.file_name() << "\";\n"
+                << "============================================================================="
+                   "=========\n"
+                << std::endl;
+    });
+  }
+}  // namespace
+
+TEST(wesos_alloc, FreeList_Allocate) {
+  deps_setup();
+
+  struct Allocation {
+    u8* m_ptr;
+    usize m_size;
+    usize m_align;
+    u8 m_fill;
+  };
+
+  std::vector<u8> storage(POOL_SIZE);
+  auto mm = alloc::FreeList(View<u8>(storage.data(), storage.size()));
+
+  const auto managed = mm.statistics().m_total_memory_managed_bytes;
+  ASSERT_GT(managed, POOL_SIZE - 64);
+  ASSERT_EQ(mm.statistics().m_total_memory_allocated_bytes, 0);
+
+  std::mt19937 rng(1234);
+  std::vector<Allocation> live;
+
+  for (usize step = 0; step < 20000; step++) {
+    if (live.empty() || rng() % 3 != 0) {
+      const usize size = 1 + (rng() % 2000);
+      const usize align = usize(1) << (rng() % 13);
+
+      auto ptr = mm.allocate_bytes(size, align);
+      if (ptr.is_null()) {
+        continue;
+      }
+
+      ASSERT_TRUE(is_aligned_pow2(ptr, align)) << "size(" << size << "), align(" << align << ")";
+
+      const auto fill = u8(step);
+      memset(ptr.unwrap(), fill, size);
+      live.push_back({static_cast<u8*>(ptr.unwrap()), size, align, fill});
+    } else {
+      const auto victim = rng() % live.size();
+      const auto a = live[victim];
+
+      for (usize i = 0; i < a.m_size; i++) {
+        ASSERT_EQ(a.m_ptr[i], a.m_fill) << "Block was overwritten";
+      }
+
+      mm.deallocate_bytes(a.m_ptr, a.m_size, a.m_align);
+      live[victim] = live.back();
+      live.pop_back();
+    }
+  }
+
+  ASSERT_GT(mm.statistics().m_total_memory_allocated_bytes, 0);
+
+  for (const auto& a : live) {
+    mm.deallocate_bytes(a.m_ptr, a.m_size, a.m_align);
+  }
+
+  ASSERT_EQ(mm.statistics().m_total_memory_allocated_bytes, 0);
+  ASSERT_EQ(mm.statistics().m_accumulated_allocations_bytes, mm.statistics().m_accumulated_deallocations_bytes);
+
+  // Every block coalesced back into one (good-fit search may skip the last 1/16th)
+  const auto most = managed - (managed / 16);
+  auto whole = mm.allocate_bytes(most, 8);
+  ASSERT_TRUE(whole.isset());
+  mm.deallocate_bytes(whole, most, 8);
+}
+
+TEST(wesos_alloc, FreeList_Exhaustion) {
+  deps_setup();
+
+  alignas(16) Array<u8, 4096> storage;
+  auto mm = alloc::FreeList(storage.as_view());
+
+  ASSERT_FALSE(mm.allocate_bytes(8192, 8).isset());
+  ASSERT_FALSE(mm.allocate_bytes(64, 4096).isset());
+
+  std::vector<void*> blocks;
+  while (auto ptr = mm.allocate_bytes(100, 8)) {
+    blocks.push_back(ptr.unwrap());
+  }
+
+  ASSERT_GE(blocks.size(), 4096 / 128 - 1);
+
+  for (auto* ptr : blocks) {
+    mm.deallocate_bytes(ptr, 100, 8);
+  }
+
+  ASSERT_TRUE(mm.allocate_bytes(2048, 8).isset());
+}
+
+TEST(wesos_alloc, FreeList_Embezzle) {
+  deps_setup();
+
+  std::vector<u8> storage(POOL_SIZE);
+  auto mm = alloc::FreeList(View<u8>(storage.data(), storage.size()));
+
+  const auto managed = mm.statistics().m_total_memory_managed_bytes;
+
+  auto taken = mm.embezzle_bytes(64 * 1024);
+  ASSERT_EQ(taken.size(), 64 * 1024);
+  memset(taken.into_ptr().unwrap(), 0, taken.size());
+
+  ASSERT_LT(mm.statistics().m_total_memory_managed_bytes, managed);
+  ASSERT_EQ(mm.statistics().m_total_memory_allocated_bytes, 0);
+
+  auto ptr = mm.allocate_bytes(1024, 64);
+  ASSERT_TRUE(ptr.isset());
+  ASSERT_TRUE(ptr.unwrap() < taken.into_ptr().unwrap() || ptr.unwrap() >= taken.end());
+  mm.deallocate_bytes(ptr, 1024, 64);
+}
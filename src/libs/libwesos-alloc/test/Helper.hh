@@ -5,6 +5,10 @@
  * it under the terms of the Unlicense(https://unlicense.org/).
  */
 
-#include <gtest/gtest.h>
+#pragma once
 
-TEST(cpu, placeholder) {}
+#include "../../libwesos-mem/test/Helper.hh"
+
+namespace wesos::alloc {
+  using mem::CountingResource;
+}  // namespace wesos::alloc
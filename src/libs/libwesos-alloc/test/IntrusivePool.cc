@@ -7,6 +7,7 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <iostream>
 #include <memory_resource>
 #include <unordered_set>
@@ -135,3 +136,37 @@ TEST(wesos_alloc, IntrusivePool_Allocate) {
     }
   }
 }
+
+TEST(wesos_alloc, IntrusivePool_LazyUtilize) {
+  deps_setup();
+
+  using namespace wesos;
+
+  constexpr usize object_size = 32;
+  constexpr usize small_count = 4;
+  constexpr usize large_count = 64;
+
+  alignas(object_size) static Array<u8, object_size * small_count> small;
+  alignas(object_size) static Array<u8, object_size * large_count> large;
+
+  /* The larger pool replaces the frontier, and the smaller one is split eagerly */
+  auto mm = alloc::IntrusivePool(object_size, object_size, small.as_view());
+  mm.utilize_bytes(large.as_view());
+
+  std::unordered_set<void*> pointers;
+
+  for (usize i = 0; i < small_count + large_count; i++) {
+    auto ptr = mm.allocate_bytes(object_size, object_size);
+    ASSERT_TRUE(ptr.isset()) << "Failed on object(" << i << ")";
+    ASSERT_FALSE(pointers.contains(ptr.unwrap()));
+
+    memset(ptr.unwrap(), 0, object_size);
+    pointers.insert(ptr.unwrap());
+  }
+
+  ASSERT_FALSE(mm.allocate_bytes(object_size, object_size).isset());
+
+  for (auto* ptr : pointers) {
+    mm.deallocate_bytes(ptr, object_size, object_size);
+  }
+}
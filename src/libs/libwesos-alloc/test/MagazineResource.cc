@@ -0,0 +1,189 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <wesos-alloc/MagazineResource.hh>
+#include <wesos-alloc/SlabResource.hh>
+
+#include "Helper.hh"
+
+using namespace wesos;
+
+namespace {
+  void deps_setup() {
+    wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+      std::cerr << "\n==========================================================================="
+                   "===========\n"
+                << "| Assertion Failed: \"" << message << "\";\n"
+                << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+                << "| File: \"" << source.file_name() << "\";\n"
+                << "============================================================================="
+                   "=========\n"
+                << std::endl;
+    });
+  }
+}  // namespace
+
+TEST(wesos_alloc, MagazineResource_Allocate) {
+  deps_setup();
+
+  struct Allocation {
+    NullableOwnPtr<void> m_ptr;
+    usize m_size;
+    usize m_align;
+  };
+
+  alloc::CountingResource inner;
+
+  {
+    alloc::MagazineResource mm(inner);
+
+    std::vector<Allocation> allocations;
+    std::unordered_set<void*> pointers;
+
+    for (usize size = 1; size <= alloc::SizeClass::MAX_SIZE * 2; size += 97) {
+      for (usize align = 1; align <= 256; align *= 4) {
+        auto ptr = mm.allocate_bytes(size, align);
+
+        ASSERT_TRUE(ptr.isset()) << "Failed on size(" << size << "), align(" << align << ")";
+        ASSERT_TRUE(is_aligned_pow2(ptr, align));
+        ASSERT_FALSE(pointers.contains(ptr.unwrap()));
+
+        memset(ptr.unwrap(), 0xa5, size);
+
+        pointers.insert(ptr.unwrap());
+        allocations.push_back({ptr, size, align});
+      }
+    }
+
+    for (const auto& a : allocations) {
+      mm.deallocate_bytes(a.m_ptr, a.m_size, a.m_align);
+    }
+
+    // A magazine's worth of churn stays in the per-CPU cache
+    const usize inner_allocations = inner.m_allocations;
+    for (usize i = 0; i < alloc::MagazineResource::MAGAZINE_ROUNDS * 4; i++) {
+      auto ptr = mm.allocate_bytes(64, 8);
+      ASSERT_TRUE(ptr.isset());
+      mm.deallocate_bytes(ptr, 64, 8);
+    }
+
+    ASSERT_EQ(inner.m_allocations, inner_allocations);
+  }
+
+  ASSERT_EQ(inner.m_live_bytes, 0);
+}
+
+TEST(wesos_alloc, MagazineResource_Threads) {
+  deps_setup();
+
+  static constexpr usize THREAD_COUNT = 8;
+  static constexpr usize ROUNDS = 2000;
+  static constexpr usize BATCH = 100;
+
+  alloc::CountingResource backing;
+
+  {
+    alloc::SlabResource slab(backing);
+    alloc::MagazineResource mm(slab);
+
+    std::vector<std::thread> threads;
+    std::vector<int> ok(THREAD_COUNT, 1);
+
+    for (usize t = 0; t < THREAD_COUNT; t++) {
+      threads.emplace_back([&, t] {
+        std::vector<void*> batch;
+
+        for (usize round = 0; round < ROUNDS; round++) {
+          const auto size = 16 + (((round * 7) + t) % 512);
+
+          for (usize i = 0; i < BATCH; i++) {
+            auto ptr = mm.allocate_bytes(size, 8);
+            if (ptr.is_null()) {
+              ok[t] = 0;
+              return;
+            }
+
+            memset(ptr.unwrap(), int(t), size);
+            batch.push_back(ptr.unwrap());
+          }
+
+          for (auto* ptr : batch) {
+            if (*static_cast<u8*>(ptr) != u8(t)) {
+              ok[t] = 0;
+            }
+
+            mm.deallocate_bytes(ptr, size, 8);
+          }
+
+          batch.clear();
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (usize t = 0; t < THREAD_COUNT; t++) {
+      ASSERT_TRUE(ok[t]) << "Thread " << t << " saw a bad block";
+    }
+  }
+
+  ASSERT_EQ(backing.m_live_bytes, 0);
+}
+
+TEST(wesos_alloc, MagazineResource_InnerExhausted) {
+  deps_setup();
+
+  mem::MemoryResourceProtocol inner;
+  alloc::MagazineResource mm(inner);
+
+  ASSERT_FALSE(mm.allocate_bytes(32, 8).isset());
+  ASSERT_FALSE(mm.allocate_bytes(alloc::SizeClass::MAX_SIZE + 1, 8).isset());
+}
+
+TEST(wesos_alloc, MagazineResource_Bulk) {
+  deps_setup();
+
+  constexpr usize batch_size = alloc::MagazineResource::MAGAZINE_ROUNDS * 3 + 7;
+
+  alloc::CountingResource inner;
+
+  {
+    alloc::MagazineResource mm(inner);
+
+    for (const usize size : {usize(48), alloc::SizeClass::MAX_SIZE + 1}) {
+      std::vector<void*> batch(batch_size);
+      auto view = View<void*>(batch.data(), batch.size());
+
+      ASSERT_EQ(mm.allocate_bulk(view, size, 16), batch_size);
+
+      std::unordered_set<void*> pointers(batch.begin(), batch.end());
+      ASSERT_EQ(pointers.size(), batch_size);
+
+      for (auto* ptr : batch) {
+        ASSERT_EQ(bit_cast<uptr>(ptr) % 16, 0);
+        memset(ptr, 0xa5, size);
+      }
+
+      /* Null entries are skipped */
+      auto* held = batch[3];
+      batch[3] = nullptr;
+      mm.deallocate_bulk(view, size, 16);
+      mm.deallocate_bytes(held, size, 16);
+    }
+  }
+
+  ASSERT_EQ(inner.m_live_bytes, 0);
+}
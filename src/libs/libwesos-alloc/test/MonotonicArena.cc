@@ -0,0 +1,118 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <iostream>
+#include <wesos-alloc/MonotonicArena.hh>
+
+#include "Helper.hh"
+
+using namespace wesos;
+
+namespace {
+  void deps_setup() {
+    wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+      std::cerr << "\n==========================================================================="
+                   "===========\n"
+                << "| Assertion Failed: \"" << message << "\";\n"
+                << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+                << "| File: \"" << source.file_name() << "\";\n"
+                << "============================================================================="
+                   "=========\n"
+                << std::endl;
+    });
+  }
+}  // namespace
+
+TEST(wesos_alloc, MonotonicArena_Allocate) {
+  deps_setup();
+
+  alloc::CountingResource upstream;
+
+  {
+    alloc::MonotonicArena mm(upstream);
+
+    for (usize size = 1; size <= 512; size += 13) {
+      for (usize align = 1; align <= 128; align *= 2) {
+        auto ptr = mm.allocate_bytes(size, align);
+
+        ASSERT_TRUE(ptr.isset()) << "Failed on size(" << size << "), align(" << align << ")";
+        ASSERT_TRUE(is_aligned_pow2(ptr, align));
+
+        memset(ptr.unwrap(), 0xcc, size);
+        mm.deallocate_bytes(ptr, size, align);
+      }
+    }
+
+    // Chunks grow geometrically, so there are only a handful of them
+    ASSERT_LT(upstream.m_allocations, 16);
+
+    auto huge = mm.allocate_bytes(alloc::MonotonicArena::MAX_CHUNK_SIZE * 2, 4096);
+    ASSERT_TRUE(huge.isset());
+    ASSERT_TRUE(is_aligned_pow2(huge, 4096));
+
+    // The chunk size would wrap around, so nothing is asked of upstream
+    const usize allocations = upstream.m_allocations;
+    ASSERT_FALSE(mm.allocate_bytes(~usize(0) - 64, 4096).isset());
+    ASSERT_EQ(upstream.m_allocations, allocations);
+  }
+
+  ASSERT_EQ(upstream.m_live_bytes, 0);
+}
+
+TEST(wesos_alloc, MonotonicArena_Reset) {
+  deps_setup();
+
+  alloc::CountingResource upstream;
+  alloc::MonotonicArena mm(upstream, 256);
+
+  for (usize round = 0; round < 4; round++) {
+    const auto first = mm.allocate_bytes(64, 8);
+    ASSERT_TRUE(first.isset());
+
+    for (usize i = 0; i < 1000; i++) {
+      ASSERT_TRUE(mm.allocate_bytes(48, 16).isset());
+    }
+
+    ASSERT_GT(upstream.m_live_bytes, 1000 * 48);
+
+    mm.reset();
+    ASSERT_EQ(upstream.m_live_bytes, 0);
+  }
+}
+
+TEST(wesos_alloc, MonotonicArena_KeepsItsChunks) {
+  deps_setup();
+
+  alloc::CountingResource upstream;
+  alloc::MonotonicArena mm(upstream, 256);
+
+  ASSERT_TRUE(mm.allocate_bytes(8, 8).isset());
+  const usize live_bytes = upstream.m_live_bytes;
+
+  // The idle tail of a chunk is upstream's memory, so it is never given away
+  ASSERT_TRUE(mm.embezzle_bytes(10000).empty());
+
+  // Donated pools would outlive reset() untracked, so they are ignored
+  alignas(64) Array<u8, 1024> storage;
+  mm.utilize_bytes(storage.as_view());
+
+  for (usize i = 0; i < 16; i++) {
+    const auto ptr = mm.allocate_bytes(8, 8);
+    ASSERT_TRUE(ptr.isset());
+
+    const auto* byte = static_cast<u8*>(ptr.unwrap());
+    ASSERT_FALSE(byte >= storage.into_ptr().unwrap() && byte < storage.end());
+  }
+
+  ASSERT_EQ(upstream.m_live_bytes, live_bytes);
+
+  mm.reset();
+  ASSERT_EQ(upstream.m_live_bytes, 0);
+}
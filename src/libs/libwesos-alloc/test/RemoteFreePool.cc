@@ -0,0 +1,147 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <wesos-alloc/RemoteFreePool.hh>
+#include <wesos-mem/MemoryEconomy.hh>
+
+using namespace wesos;
+
+namespace {
+  void deps_setup() {
+    wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+      std::cerr << "\n==========================================================================="
+                   "===========\n"
+                << "| Assertion Failed: \"" << message << "\";\n"
+                << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+                << "| File: \"" << source.file_name() << "\";\n"
+                << "============================================================================="
+                   "=========\n"
+                << std::endl;
+    });
+  }
+}  // namespace
+
+TEST(wesos_alloc, RemoteFreePool_Allocate) {
+  deps_setup();
+
+  constexpr usize object_size = 48;
+  constexpr usize object_align = 16;
+  constexpr usize object_count = 64;
+
+  /* An economy of its own, so exhaustion can't be papered over by another test's donations */
+  mem::MemoryEconomy economy;
+
+  alignas(object_align) Array<u8, object_size * object_count> storage;
+  auto mm = alloc::RemoteFreePool(object_size, object_align, storage.as_view());
+  mm.eco_join(economy);
+
+  std::unordered_set<void*> pointers;
+
+  for (usize i = 0; i < object_count; i++) {
+    auto ptr = mm.allocate_bytes(object_size, object_align);
+
+    ASSERT_TRUE(ptr.isset());
+    ASSERT_TRUE(is_aligned_pow2(ptr, object_align));
+    ASSERT_FALSE(pointers.contains(ptr.unwrap()));
+
+    memset(ptr.unwrap(), 0, object_size);
+    pointers.insert(ptr.unwrap());
+  }
+
+  ASSERT_FALSE(mm.allocate_bytes(object_size, object_align).isset());
+  ASSERT_EQ(economy.statistics().m_starvations, 1);
+
+  /* Freed blocks come back through the remote list */
+  for (auto* ptr : pointers) {
+    mm.deallocate_bytes(ptr, object_size, object_align);
+  }
+
+  auto expected_objects = pointers;
+  pointers.clear();
+
+  for (usize i = 0; i < object_count; i++) {
+    auto ptr = mm.allocate_bytes(object_size, object_align);
+    ASSERT_TRUE(ptr.isset());
+    pointers.insert(ptr.unwrap());
+  }
+
+  ASSERT_EQ(pointers, expected_objects);
+}
+
+TEST(wesos_alloc, RemoteFreePool_ProducerConsumer) {
+  deps_setup();
+
+  constexpr usize object_count = 32;
+  constexpr usize messages = 20000;
+  constexpr usize object_size = 32;
+
+  std::vector<u64> storage(object_count * object_size / sizeof(u64));
+  auto mm = alloc::RemoteFreePool(object_size, alignof(u64),
+                                  View<u8>(bit_cast<u8*>(storage.data()), storage.size() * sizeof(u64)));
+
+  /* Single-slot mailboxes: the producer fills them, the consumer checks and frees */
+  std::vector<std::atomic<u64*>> mailboxes(object_count);
+  std::atomic<bool> ok = true;
+
+  std::thread consumer([&] {
+    usize received = 0;
+
+    while (received < messages) {
+      for (auto& mailbox : mailboxes) {
+        auto* message = mailbox.exchange(nullptr, std::memory_order_acquire);
+        if (message == nullptr) {
+          std::this_thread::yield();
+          continue;
+        }
+
+        if (message[1] != ~message[0]) {
+          ok = false;
+        }
+
+        mm.deallocate_bytes(message, object_size, alignof(u64));
+        received++;
+      }
+    }
+  });
+
+  usize sent = 0;
+  while (sent < messages) {
+    auto& mailbox = mailboxes[sent % object_count];
+    if (mailbox.load(std::memory_order_relaxed) != nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    auto ptr = mm.allocate_bytes(object_size, alignof(u64));
+    if (ptr.is_null()) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    auto* message = static_cast<u64*>(ptr.unwrap());
+    message[0] = sent;
+    message[1] = ~sent;
+
+    mailbox.store(message, std::memory_order_release);
+    sent++;
+  }
+
+  consumer.join();
+
+  ASSERT_TRUE(ok);
+
+  Array<void*, object_count + 1> all;
+  ASSERT_EQ(mm.allocate_bulk(all.as_view(), object_size, alignof(u64)), object_count);
+}
@@ -0,0 +1,141 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+#include <wesos-alloc/SlabResource.hh>
+
+#include "Helper.hh"
+
+using namespace wesos;
+
+namespace {
+  void deps_setup() {
+    wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+      std::cerr << "\n==========================================================================="
+                   "===========\n"
+                << "| Assertion Failed: \"" << message << "\";\n"
+                << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+                << "| File: \"" << source.file_name() << "\";\n"
+                << "============================================================================="
+                   "=========\n"
+                << std::endl;
+    });
+  }
+}  // namespace
+
+TEST(wesos_alloc, SizeClass_Lookup) {
+  deps_setup();
+
+  using alloc::SizeClass;
+
+  for (usize i = 1; i < SizeClass::COUNT; i++) {
+    ASSERT_LT(SizeClass::size_of(i - 1), SizeClass::size_of(i));
+    if (SizeClass::size_of(i - 1) >= 32) {
+      ASSERT_LE(SizeClass::size_of(i) * 4, SizeClass::size_of(i - 1) * 5) << "Class " << i << " wastes over 25%";
+    }
+  }
+
+  for (usize size = 1; size <= SizeClass::MAX_SIZE; size++) {
+    for (usize align = 1; align <= 64; align *= 2) {
+      const auto index = SizeClass::index_of(size, align);
+      ASSERT_TRUE(index.isset()) << "size(" << size << "), align(" << align << ")";
+
+      const auto i = index.value();
+      ASSERT_GE(SizeClass::size_of(i), size);
+      ASSERT_GE(SizeClass::align_of(i).unwrap(), align);
+      ASSERT_TRUE(i == 0 || SizeClass::size_of(i - 1) < size || SizeClass::align_of(i - 1) < align);
+    }
+  }
+
+  ASSERT_FALSE(SizeClass::index_of(SizeClass::MAX_SIZE + 1, 1).isset());
+}
+
+TEST(wesos_alloc, SlabResource_Allocate) {
+  deps_setup();
+
+  struct Allocation {
+    NullableOwnPtr<void> m_ptr;
+    usize m_size;
+    usize m_align;
+  };
+
+  alloc::CountingResource backing;
+
+  {
+    alloc::SlabResource mm(backing);
+
+    std::vector<Allocation> allocations;
+    std::unordered_set<void*> pointers;
+
+    for (usize size = 1; size <= 2048; size += 7) {
+      for (usize align = 1; align <= 256; align *= 4) {
+        auto ptr = mm.allocate_bytes(size, align);
+
+        ASSERT_TRUE(ptr.isset()) << "Failed on size(" << size << "), align(" << align << ")";
+        ASSERT_TRUE(is_aligned_pow2(ptr, align));
+        ASSERT_FALSE(pointers.contains(ptr.unwrap()));
+
+        memset(ptr.unwrap(), 0xa5, size);
+
+        pointers.insert(ptr.unwrap());
+        allocations.push_back({ptr, size, align});
+      }
+    }
+
+    const usize slab_allocations = backing.m_allocations;
+
+    for (const auto& a : allocations) {
+      mm.deallocate_bytes(a.m_ptr, a.m_size, a.m_align);
+    }
+
+    // Everything fits in the slabs we already have
+    for (const auto& a : allocations) {
+      auto ptr = mm.allocate_bytes(a.m_size, a.m_align);
+      ASSERT_TRUE(ptr.isset());
+      mm.deallocate_bytes(ptr, a.m_size, a.m_align);
+    }
+
+    ASSERT_EQ(backing.m_allocations, slab_allocations);
+  }
+
+  ASSERT_EQ(backing.m_live_bytes, 0);
+}
+
+TEST(wesos_alloc, SlabResource_LargeObjects) {
+  deps_setup();
+
+  alloc::CountingResource backing;
+
+  {
+    alloc::SlabResource mm(backing);
+
+    const usize size = alloc::SizeClass::MAX_SIZE * 3;
+    auto ptr = mm.allocate_bytes(size, 64);
+
+    ASSERT_TRUE(ptr.isset());
+    ASSERT_EQ(backing.m_allocations, 1);
+    ASSERT_EQ(backing.m_live_bytes, size);
+
+    mm.deallocate_bytes(ptr, size, 64);
+    ASSERT_EQ(backing.m_live_bytes, 0);
+  }
+}
+
+TEST(wesos_alloc, SlabResource_BackingExhausted) {
+  deps_setup();
+
+  mem::MemoryResourceProtocol backing;
+  alloc::SlabResource mm(backing);
+
+  ASSERT_FALSE(mm.allocate_bytes(32, 8).isset());
+  ASSERT_FALSE(mm.allocate_bytes(alloc::SizeClass::MAX_SIZE + 1, 8).isset());
+}
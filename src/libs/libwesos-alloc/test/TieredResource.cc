@@ -0,0 +1,169 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+#include <wesos-alloc/TieredResource.hh>
+
+using namespace wesos;
+
+namespace {
+  struct Allocation {
+    void* m_ptr;
+    usize m_size;
+    usize m_align;
+  };
+
+  void deps_setup() {
+    wesos::assert::register_output_callback(nullptr, [](void*, const char* message, wesos::SourceLocation source) {
+      std::cerr << "\n==========================================================================="
+                   "===========\n"
+                << "| Assertion Failed: \"" << message << "\";\n"
+                << "| Function: [" << source.function_name() << "]: " << source.line_number() << ";\n"
+                << "| File: \"" << source.file_name() << "\";\n"
+                << "============================================================================="
+                   "=========\n"
+                << std::endl;
+    });
+  }
+}  // namespace
+
+TEST(wesos_alloc, TieredResource_Bootstrap) {
+  deps_setup();
+
+  alignas(16) static Array<u8, 4096> kickstart;
+  alloc::TieredResource mm(kickstart.as_view());
+
+  std::vector<Allocation> allocations;
+
+  /* A handful of small objects must fit before any page-sized region arrives */
+  for (usize i = 0; i < 32; i++) {
+    const auto size = 16 + ((i % 4) * 16);
+
+    auto ptr = mm.allocate_bytes(size, 8);
+    ASSERT_TRUE(ptr.isset()) << "Failed on size(" << size << ")";
+    allocations.push_back({ptr.unwrap(), size, 8});
+  }
+
+  for (const auto& allocation : allocations) {
+    mm.deallocate_bytes(allocation.m_ptr, allocation.m_size, allocation.m_align);
+  }
+}
+
+TEST(wesos_alloc, TieredResource_Grow) {
+  deps_setup();
+
+  constexpr usize region_size = 16 * 1024 * 1024;
+
+  alignas(16) static Array<u8, 4096> kickstart;
+  auto* region = static_cast<u8*>(std::aligned_alloc(4096, region_size));
+  auto _ = defer([&] { std::free(region); });
+
+  alloc::TieredResource mm(kickstart.as_view());
+
+  ASSERT_FALSE(mm.allocate_bytes(alloc::SizeClass::MAX_SIZE * 4, 4096).isset());
+
+  mm.utilize_bytes(View<u8>(region, region_size));
+
+  std::vector<Allocation> allocations;
+  std::unordered_set<void*> pointers;
+
+  for (usize i = 0; i < 600; i++) {
+    const auto size = 16 + ((i * 977) % (alloc::SizeClass::MAX_SIZE * 2));
+    const auto align = usize(1) << (i % 7);
+
+    auto ptr = mm.allocate_bytes(size, align);
+    ASSERT_TRUE(ptr.isset()) << "Failed on size(" << size << "), align(" << align << ")";
+    ASSERT_TRUE(is_aligned_pow2(ptr, align));
+    ASSERT_FALSE(pointers.contains(ptr.unwrap()));
+
+    memset(ptr.unwrap(), 0xa5, size);
+    pointers.insert(ptr.unwrap());
+    allocations.push_back({ptr.unwrap(), size, align});
+
+    /* Free every third block to mix in reuse */
+    if (i % 3 == 0) {
+      const auto victim = allocations[allocations.size() / 2];
+      allocations.erase(allocations.begin() + isize(allocations.size() / 2));
+      pointers.erase(victim.m_ptr);
+      mm.deallocate_bytes(victim.m_ptr, victim.m_size, victim.m_align);
+    }
+  }
+
+  for (const auto& allocation : allocations) {
+    mm.deallocate_bytes(allocation.m_ptr, allocation.m_size, allocation.m_align);
+  }
+
+  /* Large blocks went back to the page tier and merged again */
+  auto big = mm.allocate_bytes(region_size / 4, 4096);
+  ASSERT_TRUE(big.isset());
+  mm.deallocate_bytes(big, region_size / 4, 4096);
+}
+
+TEST(wesos_alloc, TieredResource_LargeFromFreeList) {
+  deps_setup();
+
+  constexpr usize large_size = alloc::SizeClass::MAX_SIZE + (alloc::SizeClass::MAX_SIZE / 4);
+
+  /* Too small for the buddy tier, so large blocks can only come from the free list */
+  alignas(4096) static Array<u8, alloc::TieredResource::PAGE_POOL_MIN_SIZE / 2> kickstart;
+  alloc::TieredResource mm(kickstart.as_view());
+
+  for (usize round = 0; round < 4; round++) {
+    auto ptr = mm.allocate_bytes(large_size, 4096);
+    ASSERT_TRUE(ptr.isset()) << "Failed on round(" << round << ")";
+    ASSERT_TRUE(is_aligned_pow2(ptr, 4096));
+
+    memset(ptr.unwrap(), 0xa5, large_size);
+    mm.deallocate_bytes(ptr, large_size, 4096);
+  }
+}
+
+TEST(wesos_alloc, TieredResource_LargeFromGrownFreeList) {
+  deps_setup();
+
+  constexpr usize region_size = alloc::TieredResource::PAGE_POOL_MIN_SIZE * 2;
+  constexpr usize large_size = alloc::SizeClass::MAX_SIZE + (alloc::SizeClass::MAX_SIZE / 4);
+
+  alignas(16) static Array<u8, 256> kickstart;
+  auto* region = static_cast<u8*>(std::aligned_alloc(4096, region_size));
+  auto _ = defer([&] { std::free(region); });
+
+  alloc::TieredResource mm(kickstart.as_view());
+  mm.utilize_bytes(View<u8>(region, region_size));
+
+  /* The first slab makes the free list borrow a span from the buddy tier */
+  auto small = mm.allocate_bytes(64, 8);
+  ASSERT_TRUE(small.isset());
+
+  /* Drain the buddy tier of everything that could hold a large block */
+  std::vector<void*> pages;
+  while (auto ptr = mm.allocate_bytes(alloc::SizeClass::MAX_SIZE * 2, 4096)) {
+    pages.push_back(ptr.unwrap());
+  }
+
+  /* Served by the free list out of the borrowed span, and must go back there */
+  for (usize round = 0; round < 4; round++) {
+    auto ptr = mm.allocate_bytes(large_size, 4096);
+    ASSERT_TRUE(ptr.isset()) << "Failed on round(" << round << ")";
+    ASSERT_TRUE(is_aligned_pow2(ptr, 4096));
+
+    memset(ptr.unwrap(), 0xa5, large_size);
+    mm.deallocate_bytes(ptr, large_size, 4096);
+  }
+
+  for (auto* ptr : pages) {
+    mm.deallocate_bytes(ptr, alloc::SizeClass::MAX_SIZE * 2, 4096);
+  }
+
+  mm.deallocate_bytes(small, 64, 8);
+}
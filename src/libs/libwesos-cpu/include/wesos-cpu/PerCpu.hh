@@ -0,0 +1,54 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-cpu/Topology.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::cpu {
+  /**
+   * @brief One instance of `T` per CPU, each on its own cache line.
+   * @note `local()` is only a hint; concurrent access to a slot must still be synchronized.
+   */
+  template <class T>
+  class PerCpu final {
+    struct alignas(CACHE_LINE_SIZE) Slot {
+      T m_value{};
+    };
+
+    Slot m_slots[MAX_CPUS];  // NOLINT(modernize-avoid-c-arrays)
+
+  public:
+    constexpr PerCpu() = default;
+    constexpr PerCpu(const PerCpu&) = delete;
+    constexpr PerCpu(PerCpu&&) = delete;
+    constexpr auto operator=(const PerCpu&) -> PerCpu& = delete;
+    constexpr auto operator=(PerCpu&&) -> PerCpu& = delete;
+    constexpr ~PerCpu() = default;
+
+    [[nodiscard]] constexpr auto length() const -> usize { return MAX_CPUS; }
+
+    [[nodiscard]] auto local() -> T& { return m_slots[current_cpu_hint()].m_value; }
+
+    [[nodiscard]] constexpr auto get(usize cpu) -> T& {
+      assert_invariant(cpu < MAX_CPUS);
+      return m_slots[cpu].m_value;
+    }
+
+    [[nodiscard]] constexpr auto get(usize cpu) const -> const T& {
+      assert_invariant(cpu < MAX_CPUS);
+      return m_slots[cpu].m_value;
+    }
+
+    constexpr void for_each(auto&& fn) {
+      for (auto& slot : m_slots) {
+        fn(slot.m_value);
+      }
+    }
+  };
+}  // namespace wesos::cpu
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <wesos-cpu/Target.hh>
+#include <wesos-types/Types.hh>
 
 namespace wesos::cpu {
   static inline void ephemeral_pause() {
@@ -17,6 +18,18 @@ namespace wesos::cpu {
     __builtin_ia32_pause();
 #else
 #error "This implementation of ephemeral_pause() does not support your architecure. Sorry.."
+#endif
+  }
+
+  /**
+   * @brief Reads the free-running cycle counter.
+   * @note Not serializing; only meaningful as the difference of two nearby reads on one CPU.
+   */
+  static inline auto cycle_counter() -> u64 {
+#if ARCH_X86_64 || ARCH_X86_32
+    return __builtin_ia32_rdtsc();
+#else
+#error "This implementation of cycle_counter() does not support your architecure. Sorry.."
 #endif
   }
 }  // namespace wesos::cpu
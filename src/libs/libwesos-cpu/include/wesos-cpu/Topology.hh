@@ -0,0 +1,79 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-assert/Assert.hh>
+#include <wesos-cpu/Target.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::cpu {
+  static constexpr usize MAX_CPUS = 64;
+  static constexpr usize CACHE_LINE_SIZE = 64;
+
+  namespace detail {
+    enum CpuIndexSource : u8 { CPU_INDEX_UNPROBED = 0, CPU_INDEX_NONE = 1, CPU_INDEX_TSC_AUX = 2 };
+
+    extern u8 CPU_INDEX_SOURCE_GLOBAL;
+
+    auto probe_cpu_index_source() -> u8;
+  }  // namespace detail
+
+  /**
+   * @brief Publishes `index` as the number of the calling CPU.
+   *
+   * The kernel calls this once on every CPU during bring-up, before that CPU
+   * touches any per-CPU data. It programs IA32_TSC_AUX, so it may only run in
+   * ring 0; hosted programs rely on their OS, which programs the register itself.
+   *
+   * @note `index` must be less than `MAX_CPUS`. Does nothing on CPUs without RDTSCP.
+   */
+  auto register_cpu(usize index) -> void;
+
+  /**
+   * @brief Returns whether `current_cpu_hint` can tell CPUs apart.
+   * @note False on CPUs without RDTSCP, and in ring 0 until `register_cpu` has run.
+   */
+  [[nodiscard]] auto has_cpu_index() -> bool;
+
+  /**
+   * @brief Returns how many distinct values `current_cpu_hint` may return.
+   * @note In ring 0 this is one past the highest registered index. Hosted programs
+   * cannot ask their OS from here, so they get `MAX_CPUS`.
+   */
+  [[nodiscard]] auto online_cpus() -> usize;
+
+  /**
+   * @brief Returns the index of the CPU the caller is probably running on.
+   * @note The caller may migrate at any time, so the result is only a hint for
+   * spreading contention. It is always less than `MAX_CPUS`, and always 0 when
+   * `has_cpu_index()` is false.
+   */
+  static inline auto current_cpu_hint() -> usize {
+#if ARCH_X86_64 || ARCH_X86_32
+    auto source = __atomic_load_n(&detail::CPU_INDEX_SOURCE_GLOBAL, __ATOMIC_RELAXED);
+    if (source == detail::CPU_INDEX_UNPROBED) [[unlikely]] {
+      source = detail::probe_cpu_index_source();
+    }
+
+    if (source != detail::CPU_INDEX_TSC_AUX) {
+      return 0;
+    }
+
+    /* Linux keeps the NUMA node in bits 12 and up; our own kernel leaves them clear */
+    u32 aux = 0;
+    (void)__builtin_ia32_rdtscp(&aux);
+
+    const usize index = aux & 0xfff;
+    assert_always(index < MAX_CPUS && "CPU index exceeds cpu::MAX_CPUS");
+
+    return index;
+#else
+#error "This implementation of current_cpu_hint() does not support your architecure. Sorry.."
+#endif
+  }
+}  // namespace wesos::cpu
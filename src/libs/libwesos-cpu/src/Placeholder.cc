@@ -1,8 +0,0 @@
-/*
- * This file is part of the WesOS project.
- *
- * WesOS is public domain software: you can redistribute it and/or modify
- * it under the terms of the Unlicense(https://unlicense.org/).
- */
-
-#include <wesos-cpu/Target.hh>
@@ -0,0 +1,102 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <cpuid.h>
+
+#include <wesos-builtin/Export.hh>
+#include <wesos-cpu/Topology.hh>
+
+using namespace wesos;
+using namespace wesos::cpu;
+
+namespace wesos::cpu::detail {
+  SYM_EXPORT u8 CPU_INDEX_SOURCE_GLOBAL = CPU_INDEX_UNPROBED;
+}  // namespace wesos::cpu::detail
+
+namespace wesos::cpu {
+  namespace {
+    constexpr u32 IA32_TSC_AUX = 0xc0000103;
+    constexpr u32 CPUID_EXT_EDX_RDTSCP = u32(1) << 27;
+
+    /* One past the highest index handed to `register_cpu` */
+    usize REGISTERED_CPUS_GLOBAL = 0;
+
+    auto has_rdtscp() -> bool {
+      u32 eax = 0;
+      u32 ebx = 0;
+      u32 ecx = 0;
+      u32 edx = 0;
+
+      if (__get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+      }
+
+      return (edx & CPUID_EXT_EDX_RDTSCP) != 0;
+    }
+
+    auto in_ring0() -> bool {
+      u16 cs = 0;
+      asm volatile("mov %%cs, %0" : "=r"(cs));
+      return (cs & 3) == 0;
+    }
+  }  // namespace
+}  // namespace wesos::cpu
+
+SYM_EXPORT auto detail::probe_cpu_index_source() -> u8 {
+  u8 source = CPU_INDEX_NONE;
+
+  /*
+   * A hosted OS has already programmed TSC_AUX on every CPU. In ring 0 the
+   * register holds whatever firmware left there until `register_cpu` runs.
+   */
+  if (has_rdtscp() && (!in_ring0() || __atomic_load_n(&REGISTERED_CPUS_GLOBAL, __ATOMIC_ACQUIRE) != 0)) {
+    source = CPU_INDEX_TSC_AUX;
+  }
+
+  __atomic_store_n(&CPU_INDEX_SOURCE_GLOBAL, source, __ATOMIC_RELAXED);
+  return source;
+}
+
+SYM_EXPORT auto cpu::register_cpu(usize index) -> void {
+  assert_always(index < MAX_CPUS && "CPU index exceeds cpu::MAX_CPUS");
+
+  if (!has_rdtscp()) {
+    return;
+  }
+
+  const u32 low = index;
+  const u32 high = 0;
+  asm volatile("wrmsr" : : "c"(IA32_TSC_AUX), "a"(low), "d"(high));
+
+  auto registered = __atomic_load_n(&REGISTERED_CPUS_GLOBAL, __ATOMIC_RELAXED);
+  while (registered < index + 1 && !__atomic_compare_exchange_n(&REGISTERED_CPUS_GLOBAL, &registered, index + 1, true,
+                                                                __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+  }
+
+  __atomic_store_n(&detail::CPU_INDEX_SOURCE_GLOBAL, detail::CPU_INDEX_TSC_AUX, __ATOMIC_RELAXED);
+}
+
+SYM_EXPORT auto cpu::has_cpu_index() -> bool {
+  auto source = __atomic_load_n(&detail::CPU_INDEX_SOURCE_GLOBAL, __ATOMIC_RELAXED);
+  if (source == detail::CPU_INDEX_UNPROBED) {
+    source = detail::probe_cpu_index_source();
+  }
+
+  return source == detail::CPU_INDEX_TSC_AUX;
+}
+
+SYM_EXPORT auto cpu::online_cpus() -> usize {
+  if (!has_cpu_index()) {
+    return 1;
+  }
+
+  if (in_ring0()) {
+    return __atomic_load_n(&REGISTERED_CPUS_GLOBAL, __ATOMIC_ACQUIRE);
+  }
+
+  return MAX_CPUS;
+}
@@ -0,0 +1,25 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <wesos-cpu/Topology.hh>
+
+using namespace wesos;
+
+TEST(cpu, CurrentCpuHint) {
+  const auto online = cpu::online_cpus();
+
+  ASSERT_GE(online, 1);
+  ASSERT_LE(online, cpu::MAX_CPUS);
+  ASSERT_LT(cpu::current_cpu_hint(), online);
+
+  if (!cpu::has_cpu_index()) {
+    ASSERT_EQ(cpu::current_cpu_hint(), 0);
+    ASSERT_EQ(online, 1);
+  }
+}
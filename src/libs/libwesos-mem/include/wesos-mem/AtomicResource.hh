@@ -13,6 +13,9 @@
 
 namespace wesos::mem {
   class AtomicResource final : public MemoryResourceProtocol {
+    template <class>
+    friend class StaticResource;
+
     MemoryResourceProtocol& m_inner;
     sync::SpinLock m_lock;
 
@@ -20,6 +23,9 @@ namespace wesos::mem {
     [[nodiscard]] auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
     void virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) override;
     auto virt_utilize(View<u8> pool) -> void override;
+    [[nodiscard]] auto virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize override;
+    auto virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void override;
+    [[nodiscard]] auto virt_accepts_donations() const -> bool override;
 
   public:
     AtomicResource(MemoryResourceProtocol& inner);
@@ -10,5 +10,9 @@
 namespace wesos::mem {
   class MemoryResourceProtocol;
 
+  /**
+   * @brief The thread-safe, general-purpose resource used when no other is given.
+   * @note Defined by libwesos-alloc, which provides the allocator behind it.
+   */
   [[nodiscard]] auto get_default_resource() -> MemoryResourceProtocol&;
 };  // namespace wesos::mem
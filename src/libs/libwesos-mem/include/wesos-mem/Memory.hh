@@ -30,7 +30,13 @@ namespace wesos::mem {
    *
    * This function sets up the memory system using the provided `Kickstart`
    * object as the initial buffer. It ensures that the memory system is
-   * ready for further operations.
+   * ready for further operations. Further memory regions can be added later
+   * with `get_default_resource().utilize_bytes()`; large ones (see
+   * `alloc::TieredResource::PAGE_POOL_MIN_SIZE`) back the page tier.
+   *
+   * The buffer becomes part of the default resource, which is never torn down, so
+   * it must stay valid for the rest of the program. Only the first call has any
+   * effect; later calls leave their buffer untouched and return false.
    *
    * @param initial_buffer The initial buffer used to kickstart the memory system.
    * @return true if the initialization was successful, false otherwise.
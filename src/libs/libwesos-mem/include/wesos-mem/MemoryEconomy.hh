@@ -12,25 +12,87 @@
 #include <wesos-types/Types.hh>
 
 namespace wesos::mem {
+  enum class EconomyPolicy : u8 {
+    /** @brief Every other resource is asked for an equal share of the shortfall. */
+    Proportional,
+
+    /** @brief Resources that starved recently are asked for less than idle ones. */
+    DemandWeighted,
+  };
+
+  /**
+   * @brief Moves idle memory from resources that have it to resources that need it.
+   *
+   * When a resource fails an allocation, the economy first tries to serve it from
+   * its reserve of donated memory by handing a pool to the starving resource's
+   * `virt_utilize` and retrying. Otherwise it asks the other resources to yield
+   * memory according to the active policy. Resources honour that request on their
+   * own thread the next time they are called (`eco_yield`), and whatever they
+   * embezzle is added to the reserve for the next rescue.
+   *
+   * Only resources that `eco_join` an economy take part in it. Besides the global
+   * economy, an economy can be a scoped local; destroying it detaches its members
+   * and forgets the reserve, which only ever holds memory its members yielded.
+   */
   class MemoryEconomy final {
     friend class MemoryResourceProtocol;
 
+  public:
+    struct Statistics {
+      usize m_reserve_bytes = 0;
+      usize m_donated_bytes = 0;
+      usize m_granted_bytes = 0;
+      usize m_dropped_bytes = 0;
+      usize m_starvations = 0;
+      usize m_yield_requests = 0;
+    };
+
+    static constexpr usize MIN_GRANT_SIZE = 16 * 1024;
+
+  private:
+    struct ReservePool {
+      NullableRefPtr<ReservePool> m_next;
+      usize m_size;
+
+      constexpr ReservePool(NullableRefPtr<ReservePool> next, usize size) : m_next(next), m_size(size) {}
+    };
+
     sync::SpinLock m_lock;
     NullableRefPtr<MemoryResourceProtocol> m_front;
+    NullableRefPtr<ReservePool> m_reserve;
+    EconomyPolicy m_policy = EconomyPolicy::DemandWeighted;
+    Statistics m_statistics;
 
     auto add_resource(MemoryResourceProtocol& child) -> void;
     auto remove_resource(MemoryResourceProtocol& child) -> void;
 
+    [[nodiscard]] auto take_reserve(usize min_size, usize want_size) -> View<u8>;
+    [[nodiscard]] auto carve_reserve(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void>;
+    auto request_yield(NullableRefPtr<MemoryResourceProtocol> starving, usize size) -> void;
+    [[nodiscard]] auto rescue(MemoryResourceProtocol& child, usize size, PowerOfTwo<usize> align)
+        -> NullableOwnPtr<void>;
+
   public:
     MemoryEconomy();
     MemoryEconomy(const MemoryEconomy&) = delete;
     MemoryEconomy(MemoryEconomy&&) = delete;
     auto operator=(const MemoryEconomy&) -> MemoryEconomy& = delete;
     auto operator=(MemoryEconomy&&) -> MemoryEconomy& = delete;
-    ~MemoryEconomy() = default;
+    ~MemoryEconomy();
 
-    [[nodiscard]] auto allocate(usize size) -> NullableOwnPtr<void>;
+    /**
+     * @brief Takes exactly `size` bytes aligned to `align` out of the reserve for good.
+     * @return The memory, or null after asking every resource to yield some.
+     * @note The rest of the pool it is carved from stays in the reserve.
+     */
+    [[nodiscard]] auto allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void>;
+
+    /** @brief Donates a pool to the reserve. */
     auto utilize(View<u8> pool) -> void;
+
+    auto set_policy(EconomyPolicy policy) -> void;
+    [[nodiscard]] auto policy() -> EconomyPolicy;
+    [[nodiscard]] auto statistics() -> Statistics;
   };
 
   [[nodiscard]] auto global_memory_economy() -> MemoryEconomy&;
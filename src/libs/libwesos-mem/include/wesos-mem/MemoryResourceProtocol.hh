@@ -13,12 +13,24 @@
 namespace wesos::mem {
   class MemoryEconomy;
 
+  template <class Resource>
+  class StaticResource;
+
+  [[nodiscard]] auto global_memory_economy() -> MemoryEconomy&;
+
   class MemoryResourceProtocol {
     friend class MemoryEconomy;
 
+    template <class Resource>
+    friend class StaticResource;
+
     sync::Atomic<usize> m_eco_request_size;
+    sync::Atomic<usize> m_eco_demand;
     sync::Atomic<bool> m_eco_should_yield;
     NullableRefPtr<MemoryResourceProtocol> m_eco_chain_next;
+    NullableRefPtr<MemoryEconomy> m_economy;
+
+    void eco_yield_slow();
 
   protected:
     [[nodiscard]] virtual auto virt_embezzle(usize max_size) -> View<u8>;
@@ -26,6 +38,19 @@ namespace wesos::mem {
     virtual auto virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void;
     virtual auto virt_utilize(View<u8> pool) -> void;
 
+    /**
+     * @brief Fills `out` from the front and returns how many entries were filled.
+     * @note The default calls `virt_allocate` until it fails. Override it when a batch
+     * can be served for less than the sum of its parts (one lock, one list splice).
+     */
+    [[nodiscard]] virtual auto virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize;
+
+    /** @brief Frees every non-null entry of `ptrs`. The default calls `virt_deallocate` for each. */
+    virtual auto virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void;
+
+    /** @brief Whether memory given to `virt_utilize` is put to use rather than dropped or forwarded. */
+    [[nodiscard]] virtual auto virt_accepts_donations() const -> bool;
+
   public:
     MemoryResourceProtocol();
     MemoryResourceProtocol(const MemoryResourceProtocol&) = delete;
@@ -38,7 +63,40 @@ namespace wesos::mem {
     [[nodiscard]] auto allocate_bytes(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void>;
     auto deallocate_bytes(NullableOwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void;
     auto utilize_bytes(View<u8> pool) -> void;
+    [[nodiscard]] auto accepts_donations() const -> bool { return virt_accepts_donations(); }
+
+    /**
+     * @brief Allocates up to `out.size()` objects of the same size and alignment.
+     * @return The number of entries filled, from the front of `out`. Short only if
+     * the resource and the economy both ran out of memory.
+     */
+    [[nodiscard]] auto allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize;
+
+    /** @brief Frees a batch of objects of the same size and alignment; null entries are skipped. */
+    auto deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void;
+
+    void eco_yield() {
+      if (m_eco_should_yield.load(sync::memory_order_acquire)) [[unlikely]] {
+        eco_yield_slow();
+      }
+    }
+
+    /**
+     * @brief Makes this resource a member of `economy`, leaving any economy it was in.
+     *
+     * Members are rescued from the economy's reserve when they run dry, and are asked
+     * to yield idle memory into it. Resources are not members until they join.
+     *
+     * @note Memory a member yields may be handed to any other member and stay in the
+     * reserve after this resource is gone, so only join resources whose storage
+     * outlives the economy. Never join internal parts of another resource.
+     */
+    void eco_join(MemoryEconomy& economy = global_memory_economy());
 
-    void eco_yield();
+    /**
+     * @brief Takes this resource out of its economy, if it is in one.
+     * @note Memory it already yielded stays in the economy's reserve.
+     */
+    void eco_withdraw();
   };
 }  // namespace wesos::mem
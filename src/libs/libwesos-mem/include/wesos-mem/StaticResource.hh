@@ -0,0 +1,98 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-types/Template.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::mem {
+  /**
+   * @brief Calls a resource whose concrete type is known at compile time without virtual dispatch.
+   *
+   * The fast path calls `Impl::virt_allocate` and `Impl::virt_deallocate` by
+   * qualified name, so the compiler can inline them (across translation units with
+   * LTO). Only if that allocation fails does it fall back to the dynamic protocol,
+   * which retries and, for economy members, asks the `MemoryEconomy` for help. The
+   * `eco_yield` check is an inlined load. `StaticResource<MemoryResourceProtocol>`
+   * simply forwards to the dynamic protocol, so generic code can use either.
+   *
+   * @note `Impl` must declare `template <class> friend class mem::StaticResource;`.
+   */
+  template <class Impl>
+  class StaticResource final {
+    static_assert(types::is_base_of_v<MemoryResourceProtocol, Impl>, "Impl must be a memory resource");
+
+    Impl& m_impl;
+
+    static constexpr bool IS_DYNAMIC = types::is_same_v<Impl, MemoryResourceProtocol>;
+
+  public:
+    constexpr StaticResource(Impl& impl) : m_impl(impl) {}
+    constexpr StaticResource(const StaticResource&) = default;
+    constexpr StaticResource(StaticResource&&) = default;
+    constexpr auto operator=(const StaticResource&) -> StaticResource& = delete;
+    constexpr auto operator=(StaticResource&&) -> StaticResource& = delete;
+    constexpr ~StaticResource() = default;
+
+    [[nodiscard]] constexpr auto resource() const -> Impl& { return m_impl; }
+
+    [[nodiscard]] auto allocate_bytes(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+      if constexpr (IS_DYNAMIC) {
+        return m_impl.allocate_bytes(size, align);
+      } else {
+        m_impl.eco_yield();
+
+        if (auto ptr = m_impl.Impl::virt_allocate(size, align)) [[likely]] {
+          return ptr;
+        }
+
+        return m_impl.allocate_bytes(size, align);
+      }
+    }
+
+    auto deallocate_bytes(NullableOwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) -> void {
+      if constexpr (IS_DYNAMIC) {
+        m_impl.deallocate_bytes(ptr, size, align);
+      } else {
+        m_impl.eco_yield();
+
+        if (ptr.isset()) [[likely]] {
+          m_impl.Impl::virt_deallocate(ptr.get_unchecked(), size, align);
+        }
+      }
+    }
+
+    [[nodiscard]] auto allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize {
+      if constexpr (IS_DYNAMIC) {
+        return m_impl.allocate_bulk(out, size, align);
+      } else {
+        m_impl.eco_yield();
+
+        const auto count = m_impl.Impl::virt_allocate_bulk(out, size, align);
+        if (count == out.size()) [[likely]] {
+          return count;
+        }
+
+        return count + m_impl.allocate_bulk(out.subview_unchecked(count), size, align);
+      }
+    }
+
+    auto deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void {
+      if constexpr (IS_DYNAMIC) {
+        m_impl.deallocate_bulk(ptrs, size, align);
+      } else {
+        m_impl.eco_yield();
+
+        if (!ptrs.empty()) [[likely]] {
+          m_impl.Impl::virt_deallocate_bulk(ptrs, size, align);
+        }
+      }
+    }
+  };
+}  // namespace wesos::mem
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-cpu/PerCpu.hh>
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-sync/Atomic.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::mem {
+  /**
+   * @brief Counts every call into another resource, cheaply enough to leave on.
+   *
+   * Each CPU updates its own cache-line-aligned counters with single unlocked adds
+   * (`Atomic::add_local`), so the hot path neither contends nor pays for a locked
+   * instruction. An interrupt or a context switch cannot split such an add, so threads
+   * sharing a CPU never lose counts. A thread that migrates between reading its CPU hint
+   * and adding can race with the slot's new owner, which is rare enough for statistics.
+   * Without a real CPU index every thread shares slot 0, so the counters fall back to
+   * locked adds.
+   *
+   * Live bytes are folded into a shared total only once a CPU's unflushed delta exceeds
+   * `LIVE_BATCH_BYTES`, which makes the peak accurate to within
+   * `MAX_CPUS * LIVE_BATCH_BYTES`. Request sizes and, if enabled, call latencies in
+   * cycles are kept as log2 histograms: bucket `i` counts values in `[2^(i-1), 2^i)`,
+   * and bucket 0 counts zeroes.
+   */
+  class StatsResource final : public MemoryResourceProtocol {
+    template <class>
+    friend class StaticResource;
+
+  public:
+    static constexpr usize SIZE_BUCKETS = sizeof(usize) * 8 + 1;
+    static constexpr usize LATENCY_BUCKETS = 33;
+    static constexpr usize LIVE_BATCH_BYTES = 64 * 1024;
+
+    struct Snapshot {
+      u64 m_allocations = 0;
+      u64 m_failed_allocations = 0;
+      u64 m_deallocations = 0;
+      u64 m_allocated_bytes = 0;
+      u64 m_deallocated_bytes = 0;
+      u64 m_live_bytes = 0;
+      u64 m_peak_bytes = 0;
+      Array<u64, SIZE_BUCKETS> m_size_histogram;
+      Array<u64, LATENCY_BUCKETS> m_latency_histogram;
+    };
+
+    [[nodiscard]] static constexpr auto bucket_of(u64 value) -> usize {
+      return value == 0 ? 0 : (sizeof(u64) * 8) - static_cast<usize>(__builtin_clzll(value));
+    }
+
+  private:
+    /* Successful allocations are the sum of the size histogram */
+    struct Counters {
+      sync::Atomic<u64> m_failed_allocations;
+      sync::Atomic<u64> m_deallocations;
+      sync::Atomic<u64> m_allocated_bytes;
+      sync::Atomic<u64> m_deallocated_bytes;
+      sync::Atomic<i64> m_flushed_live_bytes;
+      Array<sync::Atomic<u64>, SIZE_BUCKETS> m_size_histogram;
+      Array<sync::Atomic<u64>, LATENCY_BUCKETS> m_latency_histogram;
+    };
+
+    MemoryResourceProtocol& m_inner;
+    bool m_time_calls;
+    bool m_shared_slots;
+    sync::Atomic<i64> m_live_bytes;
+    sync::Atomic<i64> m_peak_bytes;
+    cpu::PerCpu<Counters> m_counters;
+
+    auto flush_live(Counters& counters) -> void;
+    auto bump(sync::Atomic<u64>& counter, u64 amount) const -> void;
+    auto record_latency(Counters& counters, u64 start) const -> void;
+
+    [[nodiscard]] auto virt_embezzle(usize max_size) -> View<u8> override;
+    [[nodiscard]] auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
+    void virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) override;
+    auto virt_utilize(View<u8> pool) -> void override;
+    [[nodiscard]] auto virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize override;
+    auto virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void override;
+    [[nodiscard]] auto virt_accepts_donations() const -> bool override;
+
+  public:
+    /**
+     * @param time_calls Also record per-call latency. This costs two cycle counter
+     * reads per call, so it is off by default.
+     */
+    StatsResource(MemoryResourceProtocol& inner, bool time_calls = false);
+    StatsResource(const StatsResource&) = delete;
+    StatsResource(StatsResource&&) = delete;
+    auto operator=(const StatsResource&) -> StatsResource& = delete;
+    auto operator=(StatsResource&&) -> StatsResource& = delete;
+    ~StatsResource() override = default;
+
+    /**
+     * @brief Sums the counters of every CPU.
+     * @note Counters are read one at a time while other CPUs keep updating them, so
+     * a snapshot taken under load is only approximately consistent.
+     */
+    [[nodiscard]] auto snapshot() const -> Snapshot;
+  };
+}  // namespace wesos::mem
@@ -0,0 +1,109 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-cpu/PerCpu.hh>
+#include <wesos-sync/Atomic.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::mem {
+  enum class TraceOp : u8 {
+    Allocate,
+    Deallocate,
+    Utilize,
+    Embezzle,
+  };
+
+  /**
+   * @brief One traced call, as stored in a dump.
+   * @note `m_ptr` is null for a failed allocation. `m_sequence` orders the records
+   * of one ring; `m_timestamp` (in cycles) orders records across rings. `m_cpu` is
+   * always 0 when `cpu::has_cpu_index()` is false.
+   */
+  struct TraceRecord {
+    u64 m_sequence;
+    u64 m_timestamp;
+    u64 m_ptr;
+    u64 m_size;
+    u32 m_align;
+    u16 m_cpu;
+    TraceOp m_op;
+    u8 m_reserved;
+  };
+
+  static_assert(sizeof(TraceRecord) == 40, "TraceRecord is part of the dump format");
+
+  /** @brief Leads a dump; the records follow until the end of the stream. */
+  struct TraceDumpHeader {
+    u32 m_magic;
+    u16 m_version;
+    u16 m_record_size;
+  };
+
+  static_assert(sizeof(TraceDumpHeader) == 8, "TraceDumpHeader is part of the dump format");
+
+  /**
+   * @brief Flight recorder of `TraceRecord`s in one ring per CPU.
+   *
+   * The storage passed to the constructor is split evenly between one ring per CPU
+   * online at the time (`cpu::online_cpus()`). Without a real CPU index that is a
+   * single shared ring. CPUs brought up later share the existing rings. Each
+   * ring holds a power-of-two number of records and overwrites its oldest record
+   * when full. Appending is wait-free: a writer claims a position with one atomic
+   * add and publishes the record by storing its sequence number last, so `dump`
+   * can skip records that are being overwritten while it reads them.
+   */
+  class TraceBuffer final {
+  public:
+    static constexpr u32 DUMP_MAGIC = 0x43525457;  // "WTRC"
+    static constexpr u16 DUMP_VERSION = 1;
+
+    using WriteCallback = void (*)(void* context, const void* data, usize size);
+
+  private:
+    struct Slot {
+      sync::Atomic<u64> m_sequence;
+      TraceRecord m_record;
+    };
+
+    struct Ring {
+      sync::Atomic<u64> m_head;
+      NullableRefPtr<Slot> m_slots;
+      usize m_mask = 0;
+    };
+
+    cpu::PerCpu<Ring> m_rings;
+    usize m_ring_count = 0;
+    usize m_capacity = 0;
+
+  public:
+    TraceBuffer(View<u8> storage);
+    TraceBuffer(const TraceBuffer&) = delete;
+    TraceBuffer(TraceBuffer&&) = delete;
+    auto operator=(const TraceBuffer&) -> TraceBuffer& = delete;
+    auto operator=(TraceBuffer&&) -> TraceBuffer& = delete;
+    ~TraceBuffer() = default;
+
+    /** @brief Number of records each CPU's ring holds; 0 if the storage was too small. */
+    [[nodiscard]] constexpr auto capacity() const -> usize { return m_capacity; }
+
+    /** @brief Number of rings the storage was split into; 0 if it was too small. */
+    [[nodiscard]] constexpr auto ring_count() const -> usize { return m_ring_count; }
+
+    auto record(TraceOp op, const void* ptr, usize size, usize align) -> void;
+
+    /**
+     * @brief Writes a `TraceDumpHeader` followed by every record still in the rings.
+     * @note Safe to call while other CPUs keep recording.
+     */
+    auto dump(void* context, WriteCallback write) const -> void;
+
+    /** @brief Forgets every record. Must not race with `record` or `dump`. */
+    auto clear() -> void;
+  };
+}  // namespace wesos::mem
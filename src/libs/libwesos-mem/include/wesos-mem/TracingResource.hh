@@ -8,19 +8,31 @@
 #pragma once
 
 #include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-mem/TraceBuffer.hh>
 #include <wesos-types/Types.hh>
 
 namespace wesos::mem {
+  /**
+   * @brief Logs every call into another resource.
+   *
+   * In text mode each call is formatted through a `PrintCallback`. In binary mode
+   * each call appends a fixed-size `TraceRecord` to a `TraceBuffer`, which is
+   * cheap enough for hot paths; dump the buffer and decode it offline.
+   */
   class TracingResource final : public MemoryResourceProtocol {
     [[nodiscard]] auto virt_embezzle(usize max_size) -> View<u8> override;
     [[nodiscard]] auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override;
     void virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) override;
     auto virt_utilize(View<u8> pool) -> void override;
+    [[nodiscard]] auto virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize override;
+    auto virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void override;
+    [[nodiscard]] auto virt_accepts_donations() const -> bool override;
 
   public:
     using PrintCallback = int (*)(const char* fmt, ...);
 
     TracingResource(MemoryResourceProtocol& debugee, PrintCallback print);
+    TracingResource(MemoryResourceProtocol& debugee, TraceBuffer& buffer);
     TracingResource(const TracingResource&) = delete;
     TracingResource(TracingResource&&) = delete;
     auto operator=(const TracingResource&) -> TracingResource& = delete;
@@ -29,6 +41,7 @@ namespace wesos::mem {
 
   private:
     MemoryResourceProtocol& m_debugee;
-    PrintCallback m_print;
+    PrintCallback m_print = nullptr;
+    NullableRefPtr<TraceBuffer> m_buffer;
   };
 }  // namespace wesos::mem
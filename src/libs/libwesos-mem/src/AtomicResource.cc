@@ -21,6 +21,14 @@ SYM_EXPORT void AtomicResource::virt_deallocate(OwnPtr<void> ptr, usize size, Po
   return m_lock.critical_section([&] { m_inner.deallocate_bytes(move(ptr), size, align); });
 }
 
+SYM_EXPORT auto AtomicResource::virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize {
+  return m_lock.critical_section([&] { return m_inner.allocate_bulk(out, size, align); });
+}
+
+SYM_EXPORT auto AtomicResource::virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void {
+  m_lock.critical_section([&] { m_inner.deallocate_bulk(ptrs, size, align); });
+}
+
 SYM_EXPORT auto AtomicResource::virt_utilize(View<u8> pool) -> void {
   return m_lock.critical_section([&] { m_inner.utilize_bytes(pool); });
 }
@@ -28,3 +36,5 @@ SYM_EXPORT auto AtomicResource::virt_utilize(View<u8> pool) -> void {
 SYM_EXPORT auto AtomicResource::virt_embezzle(usize max_size) -> View<u8> {
   return m_lock.critical_section([&] { return m_inner.embezzle_bytes(max_size); });
 }
+
+SYM_EXPORT auto AtomicResource::virt_accepts_donations() const -> bool { return m_inner.accepts_donations(); }
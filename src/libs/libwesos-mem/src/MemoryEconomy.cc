@@ -11,32 +11,243 @@
 using namespace wesos;
 using namespace wesos::mem;
 
+static constexpr usize RESCUE_ATTEMPTS = 4;
+static constexpr usize RESCUE_SLACK = 64;
+
+/* Coarse log2 bucket so demand weights stay small enough to multiply without overflow */
+static constexpr auto demand_level(usize demand) -> usize {
+  return demand == 0 ? 0 : (sizeof(u64) * 8) - static_cast<usize>(__builtin_clzll(static_cast<u64>(demand)));
+}
+
+static constexpr usize MAX_DEMAND_LEVEL = sizeof(u64) * 8;
+
 SYM_EXPORT MemoryEconomy::MemoryEconomy() {}
 
-SYM_EXPORT auto MemoryEconomy::allocate(usize size) -> NullableOwnPtr<void> {
+SYM_EXPORT MemoryEconomy::~MemoryEconomy() {
   m_lock.critical_section([&] {
-    /* Request that all children yield some of their memory */
-    for (auto node = m_front; node.isset(); node = node->m_eco_chain_next) {
-      node->m_eco_request_size.fetch_add(size);
-      node->m_eco_should_yield.store(true);
+    while (m_front.isset()) {
+      const auto node = m_front;
+      m_front = node->m_eco_chain_next;
+
+      node->m_eco_chain_next = null;
+      node->m_economy = null;
+      node->m_eco_should_yield.store(false, sync::memory_order_relaxed);
     }
   });
+}
+
+SYM_EXPORT auto MemoryEconomy::allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  if (auto ptr = carve_reserve(size, align)) [[likely]] {
+    return ptr;
+  }
+
+  request_yield(null, size + align.unwrap());
 
   return null;
 }
 
 SYM_EXPORT auto MemoryEconomy::utilize(View<u8> pool) -> void {
+  pool.align_or_truncate_to(alignof(ReservePool));
+
   m_lock.critical_section([&] {
-    // TODO: distribute memory across children (uniformly?)
-    (void)pool;
+    if (pool.size() < sizeof(ReservePool)) [[unlikely]] {
+      m_statistics.m_dropped_bytes += pool.size();
+      return;
+    }
+
+    m_reserve = ::new (pool.into_ptr().unwrap()) ReservePool(m_reserve, pool.size());
+    m_statistics.m_donated_bytes += pool.size();
+    m_statistics.m_reserve_bytes += pool.size();
   });
 }
 
+SYM_EXPORT auto MemoryEconomy::set_policy(EconomyPolicy policy) -> void {
+  m_lock.critical_section([&] { m_policy = policy; });
+}
+
+SYM_EXPORT auto MemoryEconomy::policy() -> EconomyPolicy {
+  return m_lock.critical_section([&] { return m_policy; });
+}
+
+SYM_EXPORT auto MemoryEconomy::statistics() -> Statistics {
+  return m_lock.critical_section([&] { return m_statistics; });
+}
+
+auto MemoryEconomy::take_reserve(usize min_size, usize want_size) -> View<u8> {
+  return m_lock.critical_section([&]() -> View<u8> {
+    for (NullableRefPtr<ReservePool> node = m_reserve, prev = null; node.isset();
+         prev = node, node = node->m_next) {
+      const auto pool_size = node->m_size;
+      if (pool_size < min_size) {
+        continue;
+      }
+
+      auto* base = bit_cast<u8*>(node.unwrap());
+      View<u8> taken;
+
+      /* Carve from the tail when the rest can stay in the reserve, else take the whole pool */
+      if (pool_size >= want_size + sizeof(ReservePool)) {
+        node->m_size -= want_size;
+        taken = View<u8>(base + node->m_size, want_size);
+      } else {
+        if (prev.isset()) {
+          prev->m_next = node->m_next;
+        } else {
+          m_reserve = node->m_next;
+        }
+
+        node->~ReservePool();
+        taken = View<u8>(base, pool_size);
+      }
+
+      m_statistics.m_reserve_bytes -= taken.size();
+      m_statistics.m_granted_bytes += taken.size();
+
+      return taken;
+    }
+
+    return View<u8>::create_empty();
+  });
+}
+
+auto MemoryEconomy::carve_reserve(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  return m_lock.critical_section([&]() -> NullableOwnPtr<void> {
+    for (NullableRefPtr<ReservePool> node = m_reserve, prev = null; node.isset();
+         prev = node, node = node->m_next) {
+      const auto pool_size = node->m_size;
+      const auto base = bit_cast<uptr>(node.unwrap());
+      const auto end = base + pool_size;
+
+      if (pool_size < size) {
+        continue;
+      }
+
+      /* Carve from the tail so the pool keeps its header and stays where it is */
+      const auto start = (end - size) & ~(align.unwrap() - 1);
+      if (start < base) {
+        continue;
+      }
+
+      usize kept = 0;
+
+      if (start - base >= sizeof(ReservePool)) {
+        node->m_size = start - base;
+        kept += node->m_size;
+      } else {
+        if (prev.isset()) {
+          prev->m_next = node->m_next;
+        } else {
+          m_reserve = node->m_next;
+        }
+
+        node->~ReservePool();
+      }
+
+      /* Whatever alignment left behind the block goes back too, if it can hold a header */
+      auto tail = View<u8>(bit_cast<u8*>(start + size), end - start - size);
+      tail.align_or_truncate_to(alignof(ReservePool));
+
+      if (tail.size() >= sizeof(ReservePool)) {
+        m_reserve = ::new (tail.into_ptr().unwrap()) ReservePool(m_reserve, tail.size());
+        kept += tail.size();
+      }
+
+      m_statistics.m_reserve_bytes -= pool_size - kept;
+      m_statistics.m_granted_bytes += size;
+      m_statistics.m_dropped_bytes += pool_size - kept - size;
+
+      return bit_cast<void*>(start);
+    }
+
+    return null;
+  });
+}
+
+auto MemoryEconomy::request_yield(NullableRefPtr<MemoryResourceProtocol> starving, usize size) -> void {
+  m_lock.critical_section([&] {
+    m_statistics.m_yield_requests++;
+
+    usize total_weight = 0;
+    const auto weight_of = [&](MemoryResourceProtocol& node) -> usize {
+      if (m_policy == EconomyPolicy::Proportional) {
+        return 1;
+      }
+
+      return MAX_DEMAND_LEVEL + 1 - demand_level(node.m_eco_demand.load(sync::memory_order_relaxed));
+    };
+
+    for (auto node = m_front; node.isset(); node = node->m_eco_chain_next) {
+      if (node != starving) {
+        total_weight += weight_of(*node.get_unchecked());
+      }
+    }
+
+    if (total_weight == 0) [[unlikely]] {
+      return;
+    }
+
+    for (auto node = m_front; node.isset(); node = node->m_eco_chain_next) {
+      if (node != starving) {
+        const auto weight = weight_of(*node.get_unchecked());
+        const auto remainder = ((size % total_weight) * weight + total_weight - 1) / total_weight;
+        const auto share = ((size / total_weight) * weight) + remainder;
+
+        node->m_eco_request_size.fetch_add(share, sync::memory_order_relaxed);
+        node->m_eco_should_yield.store(true, sync::memory_order_release);
+      }
+
+      /* Demand decays each round so old spikes stop shielding a resource */
+      const auto demand = node->m_eco_demand.load(sync::memory_order_relaxed);
+      node->m_eco_demand.store(demand / 2, sync::memory_order_relaxed);
+    }
+  });
+}
+
+auto MemoryEconomy::rescue(MemoryResourceProtocol& child, usize size, PowerOfTwo<usize> align)
+    -> NullableOwnPtr<void> {
+  const auto member = m_lock.critical_section([&] {
+    const auto is_member = child.m_economy.isset() && child.m_economy.unwrap() == this;
+    m_statistics.m_starvations += is_member ? 1 : 0;
+    return is_member;
+  });
+
+  if (!member) {
+    return null;
+  }
+
+  child.m_eco_demand.fetch_add(size, sync::memory_order_relaxed);
+
+  /* Donations must also cover alignment and the child's own bookkeeping */
+  const auto min_size = size + align.unwrap() + RESCUE_SLACK;
+
+  if (child.virt_accepts_donations()) {
+    const auto want_size = max(min_size * 2, MIN_GRANT_SIZE);
+
+    for (usize attempt = 0; attempt < RESCUE_ATTEMPTS; attempt++) {
+      const auto pool = take_reserve(min_size, want_size);
+      if (pool.empty()) {
+        break;
+      }
+
+      child.virt_utilize(pool);
+
+      if (auto ptr = child.virt_allocate(size, align)) {
+        return ptr;
+      }
+    }
+  }
+
+  request_yield(&child, min_size);
+
+  return null;
+}
+
 SYM_EXPORT auto MemoryEconomy::add_resource(MemoryResourceProtocol& child) -> void {
   m_lock.critical_section([&] {
     assert_invariant(child.m_eco_chain_next.is_null());
 
     child.m_eco_chain_next = m_front;
+    child.m_economy = this;
     m_front = &child;
   });
 }
@@ -50,6 +261,7 @@ SYM_EXPORT auto MemoryEconomy::remove_resource(MemoryResourceProtocol& child) ->
       if (node.unwrap() == &child) [[unlikely]] {
         const auto next = node->m_eco_chain_next;
         child.m_eco_chain_next = null;
+        child.m_economy = null;
 
         if (prev.isset()) {
           prev->m_eco_chain_next = next;
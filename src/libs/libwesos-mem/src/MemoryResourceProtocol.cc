@@ -11,14 +11,23 @@
 
 using namespace wesos::mem;
 
-SYM_EXPORT MemoryResourceProtocol::MemoryResourceProtocol() { global_memory_economy().add_resource(*this); }
+SYM_EXPORT MemoryResourceProtocol::MemoryResourceProtocol() {}
 
-SYM_EXPORT MemoryResourceProtocol::~MemoryResourceProtocol() { global_memory_economy().remove_resource(*this); };
+SYM_EXPORT MemoryResourceProtocol::~MemoryResourceProtocol() { eco_withdraw(); };
 
 SYM_EXPORT auto MemoryResourceProtocol::allocate_bytes(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
   eco_yield();
 
-  return virt_allocate(size, align);
+  if (auto ptr = virt_allocate(size, align)) [[likely]] {
+    return ptr;
+  }
+
+  const auto economy = m_economy;
+  if (economy.is_null()) {
+    return null;
+  }
+
+  return economy->rescue(*this, size, align);
 }
 
 SYM_EXPORT auto MemoryResourceProtocol::deallocate_bytes(NullableOwnPtr<void> ptr, usize size,
@@ -30,6 +39,37 @@ SYM_EXPORT auto MemoryResourceProtocol::deallocate_bytes(NullableOwnPtr<void> pt
   }
 }
 
+SYM_EXPORT auto MemoryResourceProtocol::allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize {
+  eco_yield();
+
+  auto count = virt_allocate_bulk(out, size, align);
+  assert_invariant(count <= out.size());
+
+  const auto economy = m_economy;
+
+  while (count < out.size() && economy.isset()) [[unlikely]] {
+    const auto ptr = economy->rescue(*this, size, align);
+    if (ptr.is_null()) {
+      break;
+    }
+
+    out.set_unchecked(count++, ptr.unwrap());
+
+    /* A rescue usually leaves the resource with more than one object's worth */
+    count += virt_allocate_bulk(out.subview_unchecked(count), size, align);
+  }
+
+  return count;
+}
+
+SYM_EXPORT auto MemoryResourceProtocol::deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void {
+  eco_yield();
+
+  if (!ptrs.empty()) [[likely]] {
+    virt_deallocate_bulk(ptrs, size, align);
+  }
+}
+
 SYM_EXPORT auto MemoryResourceProtocol::utilize_bytes(View<u8> pool) -> void {
   eco_yield();
 
@@ -42,23 +82,37 @@ SYM_EXPORT auto MemoryResourceProtocol::embezzle_bytes(usize max_size) -> View<u
   return virt_embezzle(max_size);
 }
 
-SYM_EXPORT void MemoryResourceProtocol::eco_yield() {
-  if (const auto should_yield = m_eco_should_yield.load(sync::memory_order_acquire)) [[unlikely]] {
-    m_eco_should_yield.store(false, sync::memory_order_relaxed);
+SYM_EXPORT void MemoryResourceProtocol::eco_yield_slow() {
+  m_eco_should_yield.store(false, sync::memory_order_relaxed);
 
-    auto desired_size = m_eco_request_size.exchange(0, sync::memory_order_acq_rel);
+  auto desired_size = m_eco_request_size.exchange(0, sync::memory_order_acq_rel);
 
-    do {
-      const auto relinquished_memory = virt_embezzle(desired_size);
-      assert_invariant(relinquished_memory.size() <= desired_size);
+  const auto economy = m_economy;
+  if (economy.is_null()) [[unlikely]] {
+    return;
+  }
 
-      if (relinquished_memory.empty()) {
-        return;
-      }
+  do {
+    const auto relinquished_memory = virt_embezzle(desired_size);
+    assert_invariant(relinquished_memory.size() <= desired_size);
 
-      global_memory_economy().utilize(relinquished_memory);
-      desired_size -= relinquished_memory.size();
-    } while (desired_size > 0);
+    if (relinquished_memory.empty()) {
+      return;
+    }
+
+    economy->utilize(relinquished_memory);
+    desired_size -= relinquished_memory.size();
+  } while (desired_size > 0);
+}
+
+SYM_EXPORT void MemoryResourceProtocol::eco_join(MemoryEconomy& economy) {
+  eco_withdraw();
+  economy.add_resource(*this);
+}
+
+SYM_EXPORT void MemoryResourceProtocol::eco_withdraw() {
+  if (const auto economy = m_economy; economy.isset()) {
+    economy->remove_resource(*this);
   }
 }
 
@@ -66,3 +120,29 @@ SYM_EXPORT auto MemoryResourceProtocol::virt_embezzle(usize) -> View<u8> { retur
 SYM_EXPORT auto MemoryResourceProtocol::virt_allocate(usize, PowerOfTwo<usize>) -> NullableOwnPtr<void> { return null; }
 SYM_EXPORT auto MemoryResourceProtocol::virt_deallocate(OwnPtr<void>, usize, PowerOfTwo<usize>) -> void {}
 SYM_EXPORT auto MemoryResourceProtocol::virt_utilize(View<u8>) -> void {}
+SYM_EXPORT auto MemoryResourceProtocol::virt_accepts_donations() const -> bool { return false; }
+
+SYM_EXPORT auto MemoryResourceProtocol::virt_allocate_bulk(View<void*> out, usize size,
+                                                           PowerOfTwo<usize> align) -> usize {
+  usize count = 0;
+
+  for (; count < out.size(); count++) {
+    const auto ptr = virt_allocate(size, align);
+    if (ptr.is_null()) {
+      break;
+    }
+
+    out.set_unchecked(count, ptr.unwrap());
+  }
+
+  return count;
+}
+
+SYM_EXPORT auto MemoryResourceProtocol::virt_deallocate_bulk(View<void*> ptrs, usize size,
+                                                             PowerOfTwo<usize> align) -> void {
+  for (auto* ptr : ptrs) {
+    if (ptr != nullptr) {
+      virt_deallocate(ptr, size, align);
+    }
+  }
+}
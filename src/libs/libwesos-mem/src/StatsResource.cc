@@ -0,0 +1,164 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-builtin/Export.hh>
+#include <wesos-cpu/Timing.hh>
+#include <wesos-mem/StatsResource.hh>
+
+using namespace wesos;
+using namespace wesos::mem;
+
+SYM_EXPORT StatsResource::StatsResource(MemoryResourceProtocol& inner, bool time_calls)
+    : m_inner(inner), m_time_calls(time_calls), m_shared_slots(!cpu::has_cpu_index()) {}
+
+auto StatsResource::bump(sync::Atomic<u64>& counter, u64 amount) const -> void {
+  if (m_shared_slots) [[unlikely]] {
+    counter.fetch_add(amount, sync::memory_order_relaxed);
+    return;
+  }
+
+  counter.add_local(amount);
+}
+
+auto StatsResource::flush_live(Counters& counters) -> void {
+  const auto local = i64(counters.m_allocated_bytes.load(sync::memory_order_relaxed) -
+                         counters.m_deallocated_bytes.load(sync::memory_order_relaxed));
+  auto flushed = counters.m_flushed_live_bytes.load(sync::memory_order_relaxed);
+
+  const auto delta = local - flushed;
+  if (delta < i64(LIVE_BATCH_BYTES) && delta > -i64(LIVE_BATCH_BYTES)) [[likely]] {
+    return;
+  }
+
+  /* Whoever else shares this CPU's counters and gets here first flushes for both of us */
+  if (!counters.m_flushed_live_bytes.compare_exchange_strong(flushed, local, sync::memory_order_relaxed)) {
+    return;
+  }
+
+  const auto live = m_live_bytes.fetch_add(delta, sync::memory_order_relaxed) + delta;
+
+  auto peak = m_peak_bytes.load(sync::memory_order_relaxed);
+  while (live > peak && !m_peak_bytes.compare_exchange_weak(peak, live, sync::memory_order_relaxed)) {
+  }
+}
+
+auto StatsResource::record_latency(Counters& counters, u64 start) const -> void {
+  const auto bucket = min(bucket_of(cpu::cycle_counter() - start), LATENCY_BUCKETS - 1);
+  bump(counters.m_latency_histogram.get_unchecked(bucket), 1);
+}
+
+SYM_EXPORT auto StatsResource::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
+  const auto start = m_time_calls ? cpu::cycle_counter() : 0;
+  auto ptr = m_inner.allocate_bytes(size, align);
+
+  auto& counters = m_counters.local();
+  if (m_time_calls) {
+    record_latency(counters, start);
+  }
+
+  if (ptr.is_null()) [[unlikely]] {
+    bump(counters.m_failed_allocations, 1);
+    return ptr;
+  }
+
+  bump(counters.m_size_histogram.get_unchecked(bucket_of(size)), 1);
+  bump(counters.m_allocated_bytes, size);
+  flush_live(counters);
+
+  return ptr;
+}
+
+SYM_EXPORT void StatsResource::virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) {
+  const auto start = m_time_calls ? cpu::cycle_counter() : 0;
+  m_inner.deallocate_bytes(ptr, size, align);
+
+  auto& counters = m_counters.local();
+  if (m_time_calls) {
+    record_latency(counters, start);
+  }
+
+  bump(counters.m_deallocations, 1);
+  bump(counters.m_deallocated_bytes, size);
+  flush_live(counters);
+}
+
+SYM_EXPORT auto StatsResource::virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize {
+  const auto start = m_time_calls ? cpu::cycle_counter() : 0;
+  const auto count = m_inner.allocate_bulk(out, size, align);
+
+  /* A batch is one call as far as the latency histogram is concerned */
+  auto& counters = m_counters.local();
+  if (m_time_calls) {
+    record_latency(counters, start);
+  }
+
+  if (count != out.size()) [[unlikely]] {
+    bump(counters.m_failed_allocations, out.size() - count);
+  }
+
+  if (count != 0) [[likely]] {
+    bump(counters.m_size_histogram.get_unchecked(bucket_of(size)), count);
+    bump(counters.m_allocated_bytes, count * size);
+    flush_live(counters);
+  }
+
+  return count;
+}
+
+SYM_EXPORT auto StatsResource::virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void {
+  const auto start = m_time_calls ? cpu::cycle_counter() : 0;
+  m_inner.deallocate_bulk(ptrs, size, align);
+
+  auto& counters = m_counters.local();
+  if (m_time_calls) {
+    record_latency(counters, start);
+  }
+
+  usize count = 0;
+  for (auto* ptr : ptrs) {
+    count += ptr != nullptr ? 1 : 0;
+  }
+
+  bump(counters.m_deallocations, count);
+  bump(counters.m_deallocated_bytes, count * size);
+  flush_live(counters);
+}
+
+SYM_EXPORT auto StatsResource::virt_utilize(View<u8> pool) -> void { m_inner.utilize_bytes(pool); }
+
+SYM_EXPORT auto StatsResource::virt_embezzle(usize max_size) -> View<u8> { return m_inner.embezzle_bytes(max_size); }
+
+SYM_EXPORT auto StatsResource::virt_accepts_donations() const -> bool { return m_inner.accepts_donations(); }
+
+SYM_EXPORT auto StatsResource::snapshot() const -> Snapshot {
+  Snapshot snapshot;
+
+  for (usize cpu = 0; cpu < m_counters.length(); cpu++) {
+    const auto& counters = m_counters.get(cpu);
+
+    snapshot.m_failed_allocations += counters.m_failed_allocations.load(sync::memory_order_relaxed);
+    snapshot.m_deallocations += counters.m_deallocations.load(sync::memory_order_relaxed);
+    snapshot.m_allocated_bytes += counters.m_allocated_bytes.load(sync::memory_order_relaxed);
+    snapshot.m_deallocated_bytes += counters.m_deallocated_bytes.load(sync::memory_order_relaxed);
+
+    for (usize i = 0; i < SIZE_BUCKETS; i++) {
+      const auto count = counters.m_size_histogram.get_unchecked(i).load(sync::memory_order_relaxed);
+      snapshot.m_size_histogram.get_unchecked(i) += count;
+      snapshot.m_allocations += count;
+    }
+
+    for (usize i = 0; i < LATENCY_BUCKETS; i++) {
+      snapshot.m_latency_histogram.get_unchecked(i) +=
+          counters.m_latency_histogram.get_unchecked(i).load(sync::memory_order_relaxed);
+    }
+  }
+
+  snapshot.m_live_bytes = snapshot.m_allocated_bytes - snapshot.m_deallocated_bytes;
+  snapshot.m_peak_bytes = max(u64(max(m_peak_bytes.load(sync::memory_order_relaxed), i64(0))), snapshot.m_live_bytes);
+
+  return snapshot;
+}
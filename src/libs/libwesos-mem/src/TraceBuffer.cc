@@ -0,0 +1,121 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-builtin/Export.hh>
+#include <wesos-cpu/Timing.hh>
+#include <wesos-mem/TraceBuffer.hh>
+
+using namespace wesos;
+using namespace wesos::mem;
+
+SYM_EXPORT TraceBuffer::TraceBuffer(View<u8> storage) {
+  storage.align_or_truncate_to(alignof(Slot));
+
+  const auto ring_count = cpu::online_cpus();
+  const auto slots_per_ring = storage.size() / ring_count / sizeof(Slot);
+  if (slots_per_ring == 0) {
+    return;
+  }
+
+  m_ring_count = ring_count;
+
+  /* Round down to a power of two so positions map to slots with a mask */
+  m_capacity = usize(1) << ((sizeof(u64) * 8) - 1 - static_cast<usize>(__builtin_clzll(u64(slots_per_ring))));
+
+  auto* base = storage.into_ptr().unwrap();
+  for (usize cpu = 0; cpu < m_ring_count; cpu++) {
+    auto& ring = m_rings.get(cpu);
+    auto* slots = bit_cast<Slot*>(base + (cpu * m_capacity * sizeof(Slot)));
+
+    for (usize i = 0; i < m_capacity; i++) {
+      ::new (&slots[i]) Slot();
+    }
+
+    ring.m_slots = slots;
+    ring.m_mask = m_capacity - 1;
+  }
+}
+
+SYM_EXPORT auto TraceBuffer::record(TraceOp op, const void* ptr, usize size, usize align) -> void {
+  if (m_capacity == 0) [[unlikely]] {
+    return;
+  }
+
+  /* Claiming a position is atomic, so a late CPU can safely share another's ring */
+  const auto cpu = cpu::current_cpu_hint();
+  auto& ring = m_rings.get(cpu < m_ring_count ? cpu : cpu % m_ring_count);
+
+  const auto position = ring.m_head.fetch_add(1, sync::memory_order_relaxed);
+  auto& slot = ring.m_slots.unwrap()[position & ring.m_mask];
+
+  /* Invalidate the slot before overwriting it, then publish the new record */
+  slot.m_sequence.store(0, sync::memory_order_relaxed);
+  sync::atomic_thread_fence(sync::memory_order_release);
+
+  slot.m_record = {
+      .m_sequence = position,
+      .m_timestamp = cpu::cycle_counter(),
+      .m_ptr = u64(bit_cast<uptr>(ptr)),
+      .m_size = u64(size),
+      .m_align = u32(align),
+      .m_cpu = u16(cpu),
+      .m_op = op,
+      .m_reserved = 0,
+  };
+
+  slot.m_sequence.store(position + 1, sync::memory_order_release);
+}
+
+SYM_EXPORT auto TraceBuffer::dump(void* context, WriteCallback write) const -> void {
+  const TraceDumpHeader header = {
+      .m_magic = DUMP_MAGIC,
+      .m_version = DUMP_VERSION,
+      .m_record_size = sizeof(TraceRecord),
+  };
+
+  write(context, &header, sizeof(header));
+
+  if (m_capacity == 0) {
+    return;
+  }
+
+  for (usize cpu = 0; cpu < m_ring_count; cpu++) {
+    const auto& ring = m_rings.get(cpu);
+    const auto head = ring.m_head.load(sync::memory_order_acquire);
+    const auto first = head > m_capacity ? head - m_capacity : 0;
+
+    for (auto position = first; position < head; position++) {
+      const auto& slot = ring.m_slots.unwrap()[position & ring.m_mask];
+
+      const auto sequence = slot.m_sequence.load(sync::memory_order_acquire);
+      if (sequence != position + 1) {
+        continue;
+      }
+
+      const auto record = slot.m_record;
+
+      /* Drop the copy if a writer claimed the slot while we were reading it */
+      sync::atomic_thread_fence(sync::memory_order_acquire);
+      if (slot.m_sequence.load(sync::memory_order_relaxed) != sequence) {
+        continue;
+      }
+
+      write(context, &record, sizeof(record));
+    }
+  }
+}
+
+SYM_EXPORT auto TraceBuffer::clear() -> void {
+  for (usize cpu = 0; cpu < m_ring_count; cpu++) {
+    auto& ring = m_rings.get(cpu);
+    ring.m_head.store(0, sync::memory_order_relaxed);
+
+    for (usize i = 0; i < m_capacity; i++) {
+      ring.m_slots.unwrap()[i].m_sequence.store(0, sync::memory_order_relaxed);
+    }
+  }
+}
@@ -14,30 +14,88 @@ using namespace wesos::mem;
 SYM_EXPORT TracingResource::TracingResource(MemoryResourceProtocol& debugee, PrintCallback print)
     : m_debugee(debugee), m_print(print) {}
 
+SYM_EXPORT TracingResource::TracingResource(MemoryResourceProtocol& debugee, TraceBuffer& buffer)
+    : m_debugee(debugee), m_buffer(&buffer) {}
+
 SYM_EXPORT auto TracingResource::virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> {
   auto ptr = m_debugee.allocate_bytes(size, align);
+  if (m_buffer.isset()) {
+    m_buffer->record(TraceOp::Allocate, ptr.unwrap(), size, align);
+    return ptr;
+  }
+
   m_print("TracingResource::allocate_bytes(%zu, %zu) -> %p\n", size, align.unwrap(), ptr.unwrap());
 
   return ptr;
 }
 
 SYM_EXPORT void TracingResource::virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize> align) {
+  if (m_buffer.isset()) {
+    m_buffer->record(TraceOp::Deallocate, ptr.unwrap(), size, align);
+    return m_debugee.deallocate_bytes(ptr, size, align);
+  }
+
   m_print("TracingResource::deallocate_bytes(%p, %zu, %zu)\n", ptr.unwrap(), size, align.unwrap());
 
   return m_debugee.deallocate_bytes(ptr, size, align);
 }
 
+SYM_EXPORT auto TracingResource::virt_allocate_bulk(View<void*> out, usize size, PowerOfTwo<usize> align) -> usize {
+  const auto count = m_debugee.allocate_bulk(out, size, align);
+
+  /* Log one entry per object so traces of bulk and single calls read the same */
+  for (usize i = 0; i < out.size(); i++) {
+    void* ptr = i < count ? out.get_unchecked(i) : nullptr;
+
+    if (m_buffer.isset()) {
+      m_buffer->record(TraceOp::Allocate, ptr, size, align);
+    } else {
+      m_print("TracingResource::allocate_bytes(%zu, %zu) -> %p\n", size, align.unwrap(), ptr);
+    }
+  }
+
+  return count;
+}
+
+SYM_EXPORT auto TracingResource::virt_deallocate_bulk(View<void*> ptrs, usize size, PowerOfTwo<usize> align) -> void {
+  for (auto* ptr : ptrs) {
+    if (ptr == nullptr) {
+      continue;
+    }
+
+    if (m_buffer.isset()) {
+      m_buffer->record(TraceOp::Deallocate, ptr, size, align);
+    } else {
+      m_print("TracingResource::deallocate_bytes(%p, %zu, %zu)\n", ptr, size, align.unwrap());
+    }
+  }
+
+  m_debugee.deallocate_bulk(ptrs, size, align);
+}
+
 SYM_EXPORT auto TracingResource::virt_utilize(View<u8> pool) -> void {
   m_debugee.utilize_bytes(pool);
 
+  if (m_buffer.isset()) {
+    m_buffer->record(TraceOp::Utilize, pool.into_ptr().unwrap(), pool.size(), 1);
+    return;
+  }
+
   m_print("TracingResource::utilize_bytes(%p, %zu)\n", pool.into_ptr().cast_to<void>(), pool.size());
 }
 
 SYM_EXPORT auto TracingResource::virt_embezzle(usize max_size) -> View<u8> {
   auto embezzled = m_debugee.embezzle_bytes(max_size);
 
+  if (m_buffer.isset()) {
+    m_buffer->record(TraceOp::Embezzle, embezzled.into_ptr().unwrap(), embezzled.size(), 1);
+    return embezzled;
+  }
+
   m_print("TracingResource::embezzle_bytes(%zu) -> (%p, %zu)\n", max_size, embezzled.into_ptr().cast_to<void>(),
           embezzled.size());
 
   return embezzled;
 }
+
+SYM_EXPORT auto TracingResource::virt_accepts_donations() const -> bool { return m_debugee.accepts_donations(); }
@@ -0,0 +1,33 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::mem {
+  /* Upstream resource backed by the C heap that counts what passes through it; thread-safe */
+  class CountingResource final : public MemoryResourceProtocol {
+    auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override {
+      m_allocations++;
+      m_live_bytes += size;
+      return std::aligned_alloc(align, (size + align - 1) & ~(align - 1));
+    }
+
+    auto virt_deallocate(OwnPtr<void> ptr, usize size, PowerOfTwo<usize>) -> void override {
+      m_live_bytes -= size;
+      std::free(ptr.unwrap());
+    }
+
+  public:
+    std::atomic<usize> m_allocations = 0;
+    std::atomic<usize> m_live_bytes = 0;
+  };
+}  // namespace wesos::mem
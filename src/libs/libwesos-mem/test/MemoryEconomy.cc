@@ -0,0 +1,179 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <wesos-mem/AtomicResource.hh>
+#include <wesos-mem/MemoryEconomy.hh>
+#include <wesos-types/Types.hh>
+
+using namespace wesos;
+using namespace wesos::mem;
+
+namespace {
+  /* Bump allocator that can give away the untouched tail of its pool */
+  class BumpResource final : public MemoryResourceProtocol {
+    View<u8> m_pool;
+    bool m_accepts;
+
+    auto virt_allocate(usize size, PowerOfTwo<usize> align) -> NullableOwnPtr<void> override {
+      auto pool = m_pool;
+      pool.align_or_truncate_to(align);
+      if (pool.size() < size) {
+        return null;
+      }
+
+      m_pool = pool.subview_unchecked(size);
+      return pool.into_ptr().unwrap();
+    }
+
+    auto virt_embezzle(usize max_size) -> View<u8> override {
+      const auto size = min(max_size, m_pool.size());
+      m_pool.remove_suffix(size);
+      m_embezzled += size;
+
+      return View<u8>(m_pool.end(), size);
+    }
+
+    auto virt_utilize(View<u8> pool) -> void override { m_pool = pool.size() > m_pool.size() ? pool : m_pool; }
+    [[nodiscard]] auto virt_accepts_donations() const -> bool override { return m_accepts; }
+
+  public:
+    usize m_embezzled = 0;
+
+    BumpResource(View<u8> pool, bool accepts) : m_pool(pool), m_accepts(accepts) {}
+  };
+}  // namespace
+
+TEST(wesos_mem, MemoryEconomy_Rescue) {
+  alignas(16) static Array<u8, 64 * 1024> donor_storage;
+
+  MemoryEconomy economy;
+  economy.set_policy(EconomyPolicy::Proportional);
+
+  BumpResource donor(donor_storage.as_view(), false);
+  BumpResource starving(View<u8>::create_empty(), true);
+  donor.eco_join(economy);
+  starving.eco_join(economy);
+
+  // Nothing in the reserve yet; the donor is asked to yield
+  ASSERT_FALSE(starving.allocate_bytes(1024, 8).isset());
+
+  // The donor honours the request on its next call
+  ASSERT_TRUE(donor.allocate_bytes(16, 8).isset());
+  ASSERT_GE(donor.m_embezzled, 1024);
+
+  // The starving resource is now served from the reserve
+  auto ptr = starving.allocate_bytes(1024, 8);
+  ASSERT_TRUE(ptr.isset());
+
+  const auto stats = economy.statistics();
+  ASSERT_GE(stats.m_donated_bytes, 1024);
+  ASSERT_GE(stats.m_granted_bytes, 1024);
+  ASSERT_EQ(stats.m_starvations, 2);
+  ASSERT_EQ(stats.m_yield_requests, 1);
+}
+
+TEST(wesos_mem, MemoryEconomy_DemandWeighted) {
+  alignas(16) static Array<u8, 4096> hungry_storage;
+  alignas(16) static Array<u8, 64 * 1024> idle_storage;
+
+  MemoryEconomy economy;
+  economy.set_policy(EconomyPolicy::DemandWeighted);
+
+  BumpResource hungry(hungry_storage.as_view(), false);
+  BumpResource idle(idle_storage.as_view(), false);
+  BumpResource starving(View<u8>::create_empty(), false);
+  hungry.eco_join(economy);
+  idle.eco_join(economy);
+  starving.eco_join(economy);
+
+  // `hungry` starves once, which raises its demand
+  ASSERT_FALSE(hungry.allocate_bytes(8192, 8).isset());
+  (void)idle.allocate_bytes(1, 1);
+  (void)starving.allocate_bytes(0, 1);
+
+  const auto hungry_before = hungry.m_embezzled;
+  const auto idle_before = idle.m_embezzled;
+
+  ASSERT_FALSE(starving.allocate_bytes(8192, 8).isset());
+  (void)hungry.allocate_bytes(1, 1);
+  (void)idle.allocate_bytes(1, 1);
+
+  const auto hungry_gave = hungry.m_embezzled - hungry_before;
+  const auto idle_gave = idle.m_embezzled - idle_before;
+
+  ASSERT_GT(hungry_gave, 0);
+  ASSERT_LT(hungry_gave, idle_gave);
+}
+
+TEST(wesos_mem, MemoryEconomy_JoinIsOptIn) {
+  alignas(16) static Array<u8, 64 * 1024> bystander_storage;
+  alignas(16) static Array<u8, 64 * 1024> donor_storage;
+
+  BumpResource bystander(bystander_storage.as_view(), true);
+  BumpResource starving(View<u8>::create_empty(), true);
+
+  {
+    MemoryEconomy economy;
+    BumpResource donor(donor_storage.as_view(), false);
+    donor.eco_join(economy);
+
+    // Non-members are neither rescued nor asked to yield
+    ASSERT_FALSE(starving.allocate_bytes(1024, 8).isset());
+    ASSERT_EQ(economy.statistics().m_starvations, 0);
+    ASSERT_EQ(economy.statistics().m_yield_requests, 0);
+
+    starving.eco_join(economy);
+    ASSERT_FALSE(starving.allocate_bytes(1024, 8).isset());
+    ASSERT_TRUE(donor.allocate_bytes(16, 8).isset());
+    ASSERT_EQ(bystander.m_embezzled, 0);
+    ASSERT_GE(donor.m_embezzled, 1024);
+
+    ASSERT_TRUE(starving.allocate_bytes(1024, 8).isset());
+  }
+
+  // The economy detached its members when it went away
+  ASSERT_FALSE(starving.allocate_bytes(64 * 1024, 8).isset());
+  ASSERT_TRUE(bystander.allocate_bytes(16, 8).isset());
+  ASSERT_EQ(bystander.m_embezzled, 0);
+}
+
+TEST(wesos_mem, MemoryEconomy_AllocateCarvesExactly) {
+  constexpr usize STORAGE_SIZE = 16 * 1024;
+  alignas(16) static Array<u8, STORAGE_SIZE> storage;
+
+  MemoryEconomy economy;
+  economy.utilize(storage.as_view());
+
+  auto first = economy.allocate(100, 64);
+  ASSERT_TRUE(first.isset());
+  ASSERT_TRUE(is_aligned_pow2(first, 64));
+
+  // Only the block and the alignment slack behind it left the reserve
+  auto stats = economy.statistics();
+  ASSERT_EQ(stats.m_granted_bytes, 100);
+  ASSERT_LT(STORAGE_SIZE - stats.m_reserve_bytes, 100 + 64);
+  ASSERT_EQ(stats.m_reserve_bytes + stats.m_granted_bytes + stats.m_dropped_bytes, STORAGE_SIZE);
+
+  // The remainder keeps serving requests until it runs out
+  usize served = 1;
+  while (economy.allocate(1000, 8).isset()) {
+    served++;
+  }
+
+  ASSERT_GE(served, STORAGE_SIZE / 1000);
+  ASSERT_EQ(economy.statistics().m_yield_requests, 1);
+}
+
+TEST(wesos_mem, MemoryEconomy_AtomicResourceForwardsDonations) {
+  BumpResource accepting(View<u8>::create_empty(), true);
+  BumpResource refusing(View<u8>::create_empty(), false);
+
+  ASSERT_TRUE(AtomicResource(accepting).accepts_donations());
+  ASSERT_FALSE(AtomicResource(refusing).accepts_donations());
+}
@@ -37,3 +37,11 @@ TEST(wesos_mem, MemoryResourceProtocolUtilize) {
   MemoryResourceProtocol resource;
   resource.utilize_bytes(View<u8>::create_empty());
 }
+
+TEST(wesos_mem, MemoryResourceProtocolBulk) {
+  MemoryResourceProtocol resource;
+
+  Array<void*, 4> out;
+  EXPECT_EQ(resource.allocate_bulk(out.as_view(), 16, 8), 0);
+  resource.deallocate_bulk(out.as_view(), 16, 8);
+}
@@ -0,0 +1,117 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+#include <wesos-mem/NullResource.hh>
+#include <wesos-mem/StatsResource.hh>
+#include <wesos-types/Types.hh>
+
+#include "Helper.hh"
+
+using namespace wesos;
+using namespace wesos::mem;
+
+TEST(wesos_mem, StatsResource_Counters) {
+  CountingResource upstream;
+  StatsResource stats(upstream, true);
+
+  auto small = stats.allocate_bytes(24, 8);
+  auto large = stats.allocate_bytes(1000, 16);
+  ASSERT_TRUE(small.isset());
+  ASSERT_TRUE(large.isset());
+
+  auto snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.m_allocations, 2);
+  EXPECT_EQ(snapshot.m_allocated_bytes, 1024);
+  EXPECT_EQ(snapshot.m_live_bytes, 1024);
+  EXPECT_EQ(snapshot.m_size_histogram.get(StatsResource::bucket_of(24)), 1);
+  EXPECT_EQ(snapshot.m_size_histogram.get(StatsResource::bucket_of(1000)), 1);
+  EXPECT_EQ(StatsResource::bucket_of(24), 5);
+  EXPECT_EQ(StatsResource::bucket_of(1000), 10);
+
+  stats.deallocate_bytes(small, 24, 8);
+  stats.deallocate_bytes(large, 1000, 16);
+
+  snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.m_deallocations, 2);
+  EXPECT_EQ(snapshot.m_live_bytes, 0);
+
+  u64 timed_calls = 0;
+  for (usize i = 0; i < StatsResource::LATENCY_BUCKETS; i++) {
+    timed_calls += snapshot.m_latency_histogram.get(i);
+  }
+  EXPECT_EQ(timed_calls, 4);
+}
+
+TEST(wesos_mem, StatsResource_FailedAllocation) {
+  NullResource null_resource;
+  StatsResource stats(null_resource);
+
+  EXPECT_FALSE(stats.allocate_bytes(64, 8).isset());
+
+  const auto snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.m_allocations, 0);
+  EXPECT_EQ(snapshot.m_failed_allocations, 1);
+  EXPECT_EQ(snapshot.m_latency_histogram.get(0), 0);
+}
+
+TEST(wesos_mem, StatsResource_Peak) {
+  static constexpr usize BLOCK_SIZE = 4096;
+  static constexpr usize BLOCK_COUNT = 256;
+
+  CountingResource upstream;
+  StatsResource stats(upstream);
+  std::vector<void*> blocks;
+
+  for (usize i = 0; i < BLOCK_COUNT; i++) {
+    auto ptr = stats.allocate_bytes(BLOCK_SIZE, 16);
+    ASSERT_TRUE(ptr.isset());
+    blocks.push_back(ptr.unwrap());
+  }
+
+  for (auto* ptr : blocks) {
+    stats.deallocate_bytes(ptr, BLOCK_SIZE, 16);
+  }
+
+  const auto snapshot = stats.snapshot();
+  const auto slack = cpu::MAX_CPUS * StatsResource::LIVE_BATCH_BYTES;
+
+  EXPECT_EQ(snapshot.m_live_bytes, 0);
+  EXPECT_LE(snapshot.m_peak_bytes, BLOCK_SIZE * BLOCK_COUNT);
+  EXPECT_GE(snapshot.m_peak_bytes + slack, BLOCK_SIZE * BLOCK_COUNT);
+  EXPECT_GT(snapshot.m_peak_bytes, 0);
+}
+
+TEST(wesos_mem, StatsResource_Threads) {
+  static constexpr usize THREAD_COUNT = 8;
+  static constexpr usize ROUNDS = 10000;
+
+  CountingResource upstream;
+  StatsResource stats(upstream);
+  std::vector<std::thread> threads;
+
+  for (usize t = 0; t < THREAD_COUNT; t++) {
+    threads.emplace_back([&] {
+      for (usize i = 0; i < ROUNDS; i++) {
+        auto ptr = stats.allocate_bytes(32, 8);
+        stats.deallocate_bytes(ptr, 32, 8);
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.m_allocations, THREAD_COUNT * ROUNDS);
+  EXPECT_EQ(snapshot.m_deallocations, THREAD_COUNT * ROUNDS);
+  EXPECT_EQ(snapshot.m_live_bytes, 0);
+}
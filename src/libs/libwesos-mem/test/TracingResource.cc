@@ -7,7 +7,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdarg>
+#include <vector>
 #include <wesos-mem/NullResource.hh>
 #include <wesos-mem/TracingResource.hh>
 #include <wesos-types/Types.hh>
@@ -48,3 +50,81 @@ TEST(wesos_mem, TracingResourceUtilize) {
   auto output = testing::internal::GetCapturedStdout();
   EXPECT_EQ(output, "TracingResource::utilize_bytes((nil), 0)\n");
 }
+
+namespace {
+  auto dump_records(const TraceBuffer& buffer) -> std::vector<TraceRecord> {
+    std::vector<u8> bytes;
+    buffer.dump(&bytes, [](void* context, const void* data, usize size) {
+      auto& out = *static_cast<std::vector<u8>*>(context);
+      out.insert(out.end(), static_cast<const u8*>(data), static_cast<const u8*>(data) + size);
+    });
+
+    TraceDumpHeader header;
+    EXPECT_GE(bytes.size(), sizeof(header));
+    memcpy(&header, bytes.data(), sizeof(header));
+    EXPECT_EQ(header.m_magic, TraceBuffer::DUMP_MAGIC);
+    EXPECT_EQ(header.m_record_size, sizeof(TraceRecord));
+
+    std::vector<TraceRecord> records((bytes.size() - sizeof(header)) / sizeof(TraceRecord));
+    memcpy(records.data(), bytes.data() + sizeof(header), records.size() * sizeof(TraceRecord));
+    return records;
+  }
+}  // namespace
+
+TEST(wesos_mem, TracingResourceBinary) {
+  std::vector<u8> storage(cpu::MAX_CPUS * 64 * 64);
+  TraceBuffer buffer(View<u8>(storage.data(), storage.size()));
+  ASSERT_GT(buffer.capacity(), 0);
+
+  auto null_resource = NullResource();
+  auto tracing_resource = TracingResource(null_resource, buffer);
+
+  testing::internal::CaptureStdout();
+  EXPECT_FALSE(tracing_resource.allocate_bytes(69, 16));
+  tracing_resource.deallocate_bytes(bit_cast<void*>(uptr(0xdeadbeef)), 69, 16);
+  EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+
+  auto records = dump_records(buffer);
+  ASSERT_EQ(records.size(), 2);
+
+  std::sort(records.begin(), records.end(),
+            [](const TraceRecord& a, const TraceRecord& b) { return a.m_timestamp < b.m_timestamp; });
+  const auto& allocate = records[0];
+  const auto& deallocate = records[1];
+
+  EXPECT_EQ(allocate.m_op, TraceOp::Allocate);
+  EXPECT_EQ(allocate.m_ptr, 0);
+  EXPECT_EQ(allocate.m_size, 69);
+  EXPECT_EQ(allocate.m_align, 16);
+  EXPECT_EQ(deallocate.m_op, TraceOp::Deallocate);
+  EXPECT_EQ(deallocate.m_ptr, 0xdeadbeef);
+  EXPECT_LE(allocate.m_timestamp, deallocate.m_timestamp);
+}
+
+TEST(wesos_mem, TraceBufferWraps) {
+  std::vector<u8> storage(cpu::MAX_CPUS * 64 * 4);
+  TraceBuffer buffer(View<u8>(storage.data(), storage.size()));
+  const auto capacity = buffer.capacity();
+  ASSERT_GT(capacity, 0);
+  ASSERT_EQ(buffer.ring_count(), cpu::online_cpus());
+
+  for (usize i = 0; i < capacity * 3; i++) {
+    buffer.record(TraceOp::Allocate, nullptr, i, 8);
+  }
+
+  /* The rings keep only their newest records */
+  const auto records = dump_records(buffer);
+  EXPECT_GE(records.size(), capacity);
+  EXPECT_LT(records.size(), capacity * 3);
+  EXPECT_TRUE(std::any_of(records.begin(), records.end(),
+                          [&](const TraceRecord& record) { return record.m_size == (capacity * 3) - 1; }));
+
+  buffer.clear();
+  EXPECT_TRUE(dump_records(buffer).empty());
+
+  TraceBuffer disabled(View<u8>::create_empty());
+  disabled.record(TraceOp::Allocate, nullptr, 1, 1);
+  EXPECT_EQ(disabled.capacity(), 0);
+  EXPECT_EQ(disabled.ring_count(), 0);
+  EXPECT_TRUE(dump_records(disabled).empty());
+}
@@ -0,0 +1,171 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+/**
+ * Host-side decoder for `TraceBuffer` dumps.
+ *
+ * Usage: wesos-trace-decode <dump-file> [timeline-points]
+ *
+ * Prints a summary, the live heap over time (bytes and blocks, sampled at
+ * `timeline-points` evenly spaced timestamps) and per-size churn: how many
+ * blocks of each size were allocated, freed and left live, and how long the
+ * freed ones lived on average.
+ */
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <wesos-mem/TraceBuffer.hh>
+
+using namespace wesos;
+using namespace wesos::mem;
+
+namespace {
+  struct LiveBlock {
+    u64 m_size;
+    u64 m_timestamp;
+  };
+
+  struct SizeChurn {
+    u64 m_allocations = 0;
+    u64 m_deallocations = 0;
+    u64 m_lifetime_sum = 0;
+  };
+
+  auto read_dump(const char* path, std::vector<TraceRecord>& records) -> bool {
+    FILE* stream = std::fopen(path, "rb");
+    if (stream == nullptr) {
+      std::fprintf(stderr, "error: cannot open '%s'\n", path);
+      return false;
+    }
+
+    TraceDumpHeader header;
+    if (std::fread(&header, sizeof(header), 1, stream) != 1 || header.m_magic != TraceBuffer::DUMP_MAGIC) {
+      std::fprintf(stderr, "error: '%s' is not a trace dump\n", path);
+      std::fclose(stream);
+      return false;
+    }
+
+    if (header.m_version != TraceBuffer::DUMP_VERSION || header.m_record_size != sizeof(TraceRecord)) {
+      std::fprintf(stderr, "error: unsupported dump version %u (record size %u)\n", unsigned(header.m_version),
+                   unsigned(header.m_record_size));
+      std::fclose(stream);
+      return false;
+    }
+
+    TraceRecord record;
+    while (std::fread(&record, sizeof(record), 1, stream) == 1) {
+      records.push_back(record);
+    }
+
+    std::fclose(stream);
+    return true;
+  }
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <dump-file> [timeline-points]\n", argv[0]);
+    return 2;
+  }
+
+  const u64 timeline_points = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 32;
+
+  std::vector<TraceRecord> records;
+  if (!read_dump(argv[1], records)) {
+    return 1;
+  }
+
+  /* Records are grouped by CPU in the dump; interleave them back into one timeline */
+  std::stable_sort(records.begin(), records.end(),
+                   [](const TraceRecord& a, const TraceRecord& b) { return a.m_timestamp < b.m_timestamp; });
+
+  std::unordered_map<u64, LiveBlock> live;
+  std::map<u64, SizeChurn> churn;
+  u64 live_bytes = 0;
+  u64 peak_bytes = 0;
+  u64 peak_timestamp = 0;
+  u64 failed = 0;
+  u64 unmatched = 0;
+
+  const u64 first = records.empty() ? 0 : records.front().m_timestamp;
+  const u64 last = records.empty() ? 0 : records.back().m_timestamp;
+  const u64 step = max((last - first) / max(timeline_points, u64(1)), u64(1));
+  u64 next_sample = first;
+
+  std::printf("== live heap timeline ==\n%16s %16s %12s\n", "cycles", "live_bytes", "live_blocks");
+
+  for (const auto& record : records) {
+    while (record.m_timestamp >= next_sample && next_sample <= last) {
+      std::printf("%16" PRIu64 " %16" PRIu64 " %12zu\n", next_sample - first, live_bytes, live.size());
+      next_sample += step;
+    }
+
+    switch (record.m_op) {
+      case TraceOp::Allocate: {
+        if (record.m_ptr == 0) {
+          failed++;
+          break;
+        }
+
+        live[record.m_ptr] = {record.m_size, record.m_timestamp};
+        churn[record.m_size].m_allocations++;
+        live_bytes += record.m_size;
+
+        if (live_bytes > peak_bytes) {
+          peak_bytes = live_bytes;
+          peak_timestamp = record.m_timestamp;
+        }
+        break;
+      }
+
+      case TraceOp::Deallocate: {
+        const auto it = live.find(record.m_ptr);
+        if (it == live.end()) {
+          /* Allocated before the oldest record still in the ring */
+          unmatched++;
+          break;
+        }
+
+        auto& size = churn[it->second.m_size];
+        size.m_deallocations++;
+        size.m_lifetime_sum += record.m_timestamp - it->second.m_timestamp;
+        live_bytes -= it->second.m_size;
+        live.erase(it);
+        break;
+      }
+
+      case TraceOp::Utilize:
+      case TraceOp::Embezzle: {
+        break;
+      }
+    }
+  }
+
+  std::printf("\n== churn by size ==\n%12s %12s %12s %12s %20s\n", "size", "allocs", "frees", "live",
+              "mean_lifetime_cycles");
+
+  for (const auto& [size, entry] : churn) {
+    const u64 mean_lifetime = entry.m_deallocations != 0 ? entry.m_lifetime_sum / entry.m_deallocations : 0;
+    std::printf("%12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %20" PRIu64 "\n", size, entry.m_allocations,
+                entry.m_deallocations, entry.m_allocations - entry.m_deallocations, mean_lifetime);
+  }
+
+  std::printf("\n== summary ==\n");
+  std::printf("records:            %zu\n", records.size());
+  std::printf("span (cycles):      %" PRIu64 "\n", last - first);
+  std::printf("failed allocations: %" PRIu64 "\n", failed);
+  std::printf("unmatched frees:    %" PRIu64 "\n", unmatched);
+  std::printf("peak live bytes:    %" PRIu64 " at cycle %" PRIu64 "\n", peak_bytes, peak_timestamp - first);
+  std::printf("live at end:        %" PRIu64 " bytes in %zu blocks\n", live_bytes, live.size());
+
+  return 0;
+}
@@ -6,3 +6,65 @@
  */
 
 #include <benchmark/benchmark.h>
+
+#include <vector>
+#include <wesos-alloc/IntrusivePool.hh>
+#include <wesos-smartptr/Arc.hh>
+
+using namespace wesos;
+using namespace wesos::smartptr;
+
+namespace {
+  struct Payload {
+    u64 m_data[4];
+  };
+
+  using Shared = Arc<Payload, mem::MemoryResourceProtocol>;
+
+  auto make_pool(std::vector<u8>& storage) -> alloc::IntrusivePool {
+    storage.resize(Shared::min_alloc_size() * 64);
+    return {Shared::min_alloc_size(), Shared::min_alloc_alignment(), View<u8>(storage.data(), storage.size())};
+  }
+
+  template <class Resource>
+  void arc_create_drop(benchmark::State& state) {
+    std::vector<u8> storage;
+    auto pool = make_pool(storage);
+
+    for (auto x : state) {
+      auto arc = Arc<Payload, Resource>::create(pool, Payload{});
+      benchmark::DoNotOptimize(arc);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+  }
+}  // namespace
+
+static void BM_Arc_CreateDrop_Dynamic(benchmark::State& state) { arc_create_drop<mem::MemoryResourceProtocol>(state); }
+static void BM_Arc_CreateDrop_Static(benchmark::State& state) { arc_create_drop<alloc::IntrusivePool>(state); }
+
+static void BM_Arc_CloneDrop(benchmark::State& state) {
+  std::vector<u8> storage;
+  auto pool = make_pool(storage);
+  auto arc = Shared::create(pool, Payload{});
+
+  for (auto x : state) {
+    auto clone = arc.value();
+    benchmark::DoNotOptimize(clone);
+  }
+}
+
+static void BM_Arc_RefCount(benchmark::State& state) {
+  std::vector<u8> storage;
+  auto pool = make_pool(storage);
+  auto arc = Shared::create(pool, Payload{});
+
+  for (auto x : state) {
+    benchmark::DoNotOptimize(arc->ref_count());
+  }
+}
+
+BENCHMARK(BM_Arc_CreateDrop_Dynamic);
+BENCHMARK(BM_Arc_CreateDrop_Static);
+BENCHMARK(BM_Arc_CloneDrop);
+BENCHMARK(BM_Arc_RefCount);
@@ -6,3 +6,34 @@
  */
 
 #include <benchmark/benchmark.h>
+
+#include <wesos-alloc/IntrusivePool.hh>
+#include <wesos-smartptr/Box.hh>
+
+using namespace wesos;
+using namespace wesos::smartptr;
+
+namespace {
+  struct Payload {
+    u64 m_data[4];
+  };
+
+  template <class Resource>
+  void box_create_drop(benchmark::State& state) {
+    [[gnu::aligned(alignof(Payload))]] Array<u8, sizeof(Payload) * 64> storage;
+    auto pool = alloc::IntrusivePool(sizeof(Payload), alignof(Payload), storage.as_view());
+
+    for (auto x : state) {
+      auto box = Box<Payload, Resource>::create(pool)();
+      benchmark::DoNotOptimize(box);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+  }
+}  // namespace
+
+static void BM_Box_CreateDrop_Dynamic(benchmark::State& state) { box_create_drop<mem::MemoryResourceProtocol>(state); }
+static void BM_Box_CreateDrop_Static(benchmark::State& state) { box_create_drop<alloc::IntrusivePool>(state); }
+
+BENCHMARK(BM_Box_CreateDrop_Dynamic);
+BENCHMARK(BM_Box_CreateDrop_Static);
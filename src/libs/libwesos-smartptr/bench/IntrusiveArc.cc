@@ -0,0 +1,52 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+#include <wesos-alloc/IntrusivePool.hh>
+#include <wesos-smartptr/IntrusiveArc.hh>
+
+using namespace wesos;
+using namespace wesos::smartptr;
+
+namespace {
+  struct Payload : public IntrusiveRefCount<> {
+    u64 m_data[4] = {};
+  };
+
+  using Shared = IntrusiveArc<Payload>;
+
+  auto make_pool(std::vector<u8>& storage) -> alloc::IntrusivePool {
+    storage.resize(Shared::min_alloc_size() * 64);
+    return {Shared::min_alloc_size(), Shared::min_alloc_alignment(), View<u8>(storage.data(), storage.size())};
+  }
+}  // namespace
+
+static void BM_IntrusiveArc_CreateDrop(benchmark::State& state) {
+  std::vector<u8> storage;
+  auto pool = make_pool(storage);
+
+  for (auto x : state) {
+    auto arc = Shared::create(pool);
+    benchmark::DoNotOptimize(arc);
+  }
+}
+
+static void BM_IntrusiveArc_CloneDrop(benchmark::State& state) {
+  std::vector<u8> storage;
+  auto pool = make_pool(storage);
+  auto arc = Shared::create(pool);
+
+  for (auto x : state) {
+    auto clone = arc.value();
+    benchmark::DoNotOptimize(clone);
+  }
+}
+
+BENCHMARK(BM_IntrusiveArc_CreateDrop);
+BENCHMARK(BM_IntrusiveArc_CloneDrop);
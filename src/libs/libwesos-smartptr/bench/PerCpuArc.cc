@@ -0,0 +1,59 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <vector>
+#include <wesos-alloc/AtomicIntrusivePool.hh>
+#include <wesos-smartptr/Arc.hh>
+#include <wesos-smartptr/PerCpuArc.hh>
+
+using namespace wesos;
+using namespace wesos::smartptr;
+
+static constexpr int THREADED_MAX_THREADS = 8;
+
+namespace {
+  struct Payload {
+    u64 m_data[4];
+  };
+
+  template <class Shared>
+  void clone_drop_threaded(benchmark::State& state) {
+    static std::vector<u8> storage;
+    static std::optional<alloc::AtomicIntrusivePool> pool;
+    static std::optional<Shared> shared;
+
+    if (state.thread_index() == 0) {
+      storage.resize(Shared::min_alloc_size() + Shared::min_alloc_alignment().unwrap());
+      pool.emplace(Shared::min_alloc_size(), Shared::min_alloc_alignment(), View<u8>(storage.data(), storage.size()));
+      shared.emplace(Shared::create(*pool, Payload{}).value());
+    }
+
+    for (auto x : state) {
+      auto clone = *shared;
+      benchmark::DoNotOptimize(clone);
+    }
+
+    if (state.thread_index() == 0) {
+      shared.reset();
+      pool.reset();
+    }
+  }
+}  // namespace
+
+static void BM_Arc_CloneDrop_Threaded(benchmark::State& state) {
+  clone_drop_threaded<Arc<Payload, alloc::AtomicIntrusivePool>>(state);
+}
+
+static void BM_PerCpuArc_CloneDrop_Threaded(benchmark::State& state) {
+  clone_drop_threaded<PerCpuArc<Payload, alloc::AtomicIntrusivePool>>(state);
+}
+
+BENCHMARK(BM_Arc_CloneDrop_Threaded)->ThreadRange(1, THREADED_MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_PerCpuArc_CloneDrop_Threaded)->ThreadRange(1, THREADED_MAX_THREADS)->UseRealTime();
@@ -6,3 +6,54 @@
  */
 
 #include <benchmark/benchmark.h>
+
+#include <wesos-alloc/IntrusivePool.hh>
+#include <wesos-smartptr/Rc.hh>
+
+using namespace wesos;
+using namespace wesos::smartptr;
+
+namespace {
+  struct Payload {
+    u64 m_data[4];
+  };
+
+  template <class Resource>
+  void rc_create_drop(benchmark::State& state) {
+    using Shared = Rc<Payload, Resource>;
+
+    [[gnu::aligned(Shared::min_alloc_alignment().unwrap())]] Array<u8, Shared::min_alloc_size() * 64> storage;
+    auto pool = alloc::IntrusivePool(Shared::min_alloc_size(), Shared::min_alloc_alignment(), storage.as_view());
+
+    for (auto x : state) {
+      auto rc = Shared::create(pool, Payload{});
+      benchmark::DoNotOptimize(rc);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  template <class Resource>
+  void rc_clone_drop(benchmark::State& state) {
+    using Shared = Rc<Payload, Resource>;
+
+    [[gnu::aligned(Shared::min_alloc_alignment().unwrap())]] Array<u8, Shared::min_alloc_size() * 64> storage;
+    auto pool = alloc::IntrusivePool(Shared::min_alloc_size(), Shared::min_alloc_alignment(), storage.as_view());
+    auto rc = Shared::create(pool, Payload{});
+
+    for (auto x : state) {
+      auto clone = rc.value();
+      benchmark::DoNotOptimize(clone);
+    }
+  }
+}  // namespace
+
+static void BM_Rc_CreateDrop_Dynamic(benchmark::State& state) { rc_create_drop<mem::MemoryResourceProtocol>(state); }
+static void BM_Rc_CreateDrop_Static(benchmark::State& state) { rc_create_drop<alloc::IntrusivePool>(state); }
+static void BM_Rc_CloneDrop_Dynamic(benchmark::State& state) { rc_clone_drop<mem::MemoryResourceProtocol>(state); }
+static void BM_Rc_CloneDrop_Static(benchmark::State& state) { rc_clone_drop<alloc::IntrusivePool>(state); }
+
+BENCHMARK(BM_Rc_CreateDrop_Dynamic);
+BENCHMARK(BM_Rc_CreateDrop_Static);
+BENCHMARK(BM_Rc_CloneDrop_Dynamic);
+BENCHMARK(BM_Rc_CloneDrop_Static);
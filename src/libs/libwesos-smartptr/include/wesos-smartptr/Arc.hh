@@ -8,39 +8,118 @@
 #pragma once
 
 #include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-mem/StaticResource.hh>
 #include <wesos-sync/Atomic.hh>
 #include <wesos-types/NullableRefPtr.hh>
 #include <wesos-types/Template.hh>
 
 namespace wesos::smartptr {
-  template <class Object>
+  template <class Object, class Resource>
+  class ArcWeak;
+
+  /**
+   * @brief Atomically reference-counted pointer.
+   *
+   * `create` puts the reference counts and the object in one allocation, so the
+   * counts share a cache line with the object and a drop frees one block. `adopt`
+   * takes an object that was allocated separately and gives it its own count block.
+   *
+   * All strong references together hold one count on the block. A clone or a drop
+   * therefore touches a single atomic, and only the last drop touches both.
+   *
+   * `downgrade` hands out an `ArcWeak`, which counts only on the block. When the
+   * last strong reference drops, the object is destroyed. An adopted object's memory
+   * is freed right away. An inline block stays until the last weak reference drops
+   * too, so prefer `adopt` for large objects that are observed weakly.
+   */
+  template <class Object, class Resource = mem::MemoryResourceProtocol>
   class Arc {
+    friend class ArcWeak<Object, Resource>;
+
     struct State {
       sync::Atomic<usize> m_state_rc = 1;
       sync::Atomic<usize> m_data_rc = 1;
-      mem::MemoryResourceProtocol& m_mm;
+      Resource& m_mm;
+      bool m_inline;
 
-      constexpr State(mem::MemoryResourceProtocol& mm) : m_mm(mm) {}
+      constexpr State(Resource& mm, bool is_inline) : m_mm(mm), m_inline(is_inline) {}
     };
 
     NullableRefPtr<Object> m_ptr;
     NullableRefPtr<State> m_state;
 
-    // constexpr Arc(OwnPtr<Object> ptr, OwnPtr<State> state) : m_ptr(ptr), m_state(state) {}
+    constexpr Arc(OwnPtr<Object> ptr, OwnPtr<State> state) : m_ptr(ptr), m_state(state) {}
+
+    [[nodiscard]] static constexpr auto object_offset() -> usize {
+      return (sizeof(State) + alignof(Object) - 1) & ~(alignof(Object) - 1);
+    }
+
+    [[nodiscard]] static constexpr auto block_size() -> usize { return object_offset() + sizeof(Object); }
+
+    [[nodiscard]] static constexpr auto block_alignment() -> PowerOfTwo<usize> {
+      return max(alignof(State), alignof(Object));
+    }
+
+    static constexpr void drop_state(State* state) {
+      if (state->m_state_rc.fetch_sub(1, sync::memory_order_release) != 1) [[likely]] {
+        return;
+      }
+
+      sync::atomic_thread_fence(sync::memory_order_acquire);
+
+      auto resource = mem::StaticResource<Resource>(state->m_mm);
+      const auto is_inline = state->m_inline;
+
+      state->~State();
+
+      if (is_inline) {
+        resource.deallocate_bytes(state, block_size(), block_alignment());
+      } else {
+        resource.deallocate_bytes(state, sizeof(State), alignof(State));
+      }
+    }
+
+    constexpr void release() {
+      if (m_state.is_null()) {
+        return;
+      }
+
+      if (m_state->m_data_rc.fetch_sub(1, sync::memory_order_release) == 1) [[unlikely]] {
+        sync::atomic_thread_fence(sync::memory_order_acquire);
+
+        unwrap()->~Object();
+        if (!m_state->m_inline) {
+          mem::StaticResource<Resource>(m_state->m_mm).deallocate_bytes(unwrap(), sizeof(Object), alignof(Object));
+        }
+
+        drop_state(m_state.unwrap());
+      }
+
+      m_ptr = null;
+      m_state = null;
+    }
 
   public:
     constexpr Arc() = delete;
 
     constexpr Arc(const Arc& o) : m_ptr(o.m_ptr), m_state(o.m_state) {
-      ++m_state->m_state_rc;
-      ++m_state->m_data_rc;
+      if (m_state.isset()) {
+        m_state->m_data_rc.fetch_add(1, sync::memory_order_relaxed);
+      }
     }
 
     constexpr auto operator=(const Arc& o) -> Arc& {
-      m_ptr = o.m_ptr;
-      m_state = o.m_state;
-      ++m_state->m_state_rc;
-      ++m_state->m_data_rc;
+      if (this != &o) {
+        if (o.m_state.isset()) {
+          o.m_state->m_data_rc.fetch_add(1, sync::memory_order_relaxed);
+        }
+
+        release();
+        m_ptr = o.m_ptr;
+        m_state = o.m_state;
+      }
+
+      return *this;
     }
 
     constexpr Arc(Arc&& o) : m_ptr(o.m_ptr), m_state(o.m_state) {
@@ -49,64 +128,72 @@ namespace wesos::smartptr {
     }
 
     constexpr auto operator=(Arc&& o) -> Arc& {
-      m_ptr = o.m_ptr;
-      m_state = o.m_state;
-      o.m_ptr = null;
-      o.m_state = null;
-    };
+      if (this != &o) {
+        release();
+        m_ptr = o.m_ptr;
+        m_state = o.m_state;
+        o.m_ptr = null;
+        o.m_state = null;
+      }
 
-    constexpr ~Arc() {
-      if (m_state.isset()) {
-        if (m_ptr.isset() && --m_state->m_data_rc == 0) [[unlikely]] {
-          auto& mm = m_state->m_mm;
-          unwrap()->~Object();
-          mm.deallocate_bytes(unwrap(), sizeof(Object), alignof(Object));
-        }
+      return *this;
+    };
 
-        if (--m_state->m_state_rc == 0) [[unlikely]] {
-          auto& mm = m_state->m_mm;
-          m_state.unwrap()->~State();
-          mm.deallocate_bytes(m_state.unwrap(), sizeof(State), alignof(State));
-        }
-      }
-    }
+    constexpr ~Arc() { release(); }
 
     [[nodiscard]] constexpr auto operator<=>(const Arc& o) const { return unwrap() <=> o.unwrap(); }
     [[nodiscard]] constexpr auto operator==(types::Null) const { return is_null(); }
     [[nodiscard]] constexpr auto operator==(types::nullptr_t) const { return is_null(); }
 
-    [[nodiscard]] static constexpr auto min_alloc_size() -> usize { return max(sizeof(State), sizeof(Object)); }
-
-    [[nodiscard]] static constexpr auto min_alloc_alignment() -> PowerOfTwo<usize> {
-      return max(alignof(State), alignof(Object));
-    }
+    [[nodiscard]] static constexpr auto min_alloc_size() -> usize { return block_size(); }
+    [[nodiscard]] static constexpr auto min_alloc_alignment() -> PowerOfTwo<usize> { return block_alignment(); }
 
     template <class... Args>
-    [[nodiscard]] static constexpr auto create(mem::MemoryResourceProtocol& mm, Args&&... args) -> Nullable<Arc> {
-      const auto object_storage = mm.allocate_bytes(sizeof(Object), alignof(Object));
-      if (object_storage.is_null()) [[unlikely]] {
+    [[nodiscard]] static constexpr auto create(Resource& mm, Args&&... args) -> Nullable<Arc> {
+      const auto storage = mem::StaticResource<Resource>(mm).allocate_bytes(block_size(), block_alignment());
+      if (storage.is_null()) [[unlikely]] {
         return null;
       }
 
-      const auto state_storage = mm.allocate_bytes(sizeof(State), alignof(State));
-      if (state_storage.is_null()) [[unlikely]] {
+      auto* block = static_cast<u8*>(storage.unwrap());
+      const auto state_ptr = OwnPtr(::new (block) State(mm, true));
+      const auto object_ptr = OwnPtr(::new (block + object_offset()) Object(forward<Args>(args)...));
+
+      return Arc(object_ptr, state_ptr);
+    }
+
+    /**
+     * @brief Take shared ownership of an object that was allocated on its own.
+     *
+     * The object must come from `mm` with `sizeof(Object)` and `alignof(Object)`.
+     * If the count block cannot be allocated, null is returned and the object still
+     * belongs to the caller.
+     */
+    [[nodiscard]] static constexpr auto adopt(Resource& mm, OwnPtr<Object> object) -> Nullable<Arc> {
+      const auto storage = mem::StaticResource<Resource>(mm).allocate_bytes(sizeof(State), alignof(State));
+      if (storage.is_null()) [[unlikely]] {
         return null;
       }
 
-      ::new (object_storage.unwrap()) Object(forward<Args>(args)...);
-      const auto object_ptr = OwnPtr(static_cast<Object*>(object_storage.unwrap()));
-
-      ::new (state_storage.unwrap()) State(mm);
-      const auto state_ptr = OwnPtr(static_cast<State*>(state_storage.unwrap()));
+      const auto state_ptr = OwnPtr(::new (storage.unwrap()) State(mm, false));
 
-      return Arc(object_ptr, state_ptr);
+      return Arc(object, state_ptr);
     }
 
     //=========================================================================================
     // LIFETIME MANAGEMENT
     //=========================================================================================
 
-    [[nodiscard]] constexpr auto ref_count() const -> usize { return m_state.isset() ? m_state->m_data_rc.load() : 0; }
+    [[nodiscard]] constexpr auto ref_count() const -> usize {
+      return m_state.isset() ? m_state->m_data_rc.load(sync::memory_order_relaxed) : 0;
+    }
+
+    [[nodiscard]] constexpr auto downgrade() const -> ArcWeak<Object, Resource> {
+      assert_always(m_state.isset());
+
+      m_state->m_state_rc.fetch_add(1, sync::memory_order_relaxed);
+      return ArcWeak<Object, Resource>(OwnPtr(m_ptr.unwrap()), OwnPtr(m_state.unwrap()));
+    }
 
     //=========================================================================================
     // POINTER ACCESS
@@ -168,4 +255,98 @@ namespace wesos::smartptr {
   };
 
   static_assert(sizeof(Arc<void>) == sizeof(void*) * 2);
+
+  /**
+   * @brief Non-owning handle to an object managed by `Arc`.
+   *
+   * A weak reference keeps the count block alive but not the object. `upgrade`
+   * returns a new strong reference while the object is still alive, and null after
+   * the last strong reference has dropped.
+   */
+  template <class Object, class Resource = mem::MemoryResourceProtocol>
+  class ArcWeak {
+    friend class Arc<Object, Resource>;
+
+    using Strong = Arc<Object, Resource>;
+    using State = typename Strong::State;
+
+    NullableRefPtr<Object> m_ptr;
+    NullableRefPtr<State> m_state;
+
+    constexpr ArcWeak(OwnPtr<Object> ptr, OwnPtr<State> state) : m_ptr(ptr), m_state(state) {}
+
+    constexpr void release() {
+      if (m_state.isset()) {
+        Strong::drop_state(m_state.unwrap());
+      }
+
+      m_ptr = null;
+      m_state = null;
+    }
+
+  public:
+    constexpr ArcWeak() = delete;
+
+    constexpr ArcWeak(const ArcWeak& o) : m_ptr(o.m_ptr), m_state(o.m_state) {
+      if (m_state.isset()) {
+        m_state->m_state_rc.fetch_add(1, sync::memory_order_relaxed);
+      }
+    }
+
+    constexpr auto operator=(const ArcWeak& o) -> ArcWeak& {
+      if (this != &o) {
+        if (o.m_state.isset()) {
+          o.m_state->m_state_rc.fetch_add(1, sync::memory_order_relaxed);
+        }
+
+        release();
+        m_ptr = o.m_ptr;
+        m_state = o.m_state;
+      }
+
+      return *this;
+    }
+
+    constexpr ArcWeak(ArcWeak&& o) : m_ptr(o.m_ptr), m_state(o.m_state) {
+      o.m_ptr = null;
+      o.m_state = null;
+    }
+
+    constexpr auto operator=(ArcWeak&& o) -> ArcWeak& {
+      if (this != &o) {
+        release();
+        m_ptr = o.m_ptr;
+        m_state = o.m_state;
+        o.m_ptr = null;
+        o.m_state = null;
+      }
+
+      return *this;
+    }
+
+    constexpr ~ArcWeak() { release(); }
+
+    [[nodiscard]] constexpr auto upgrade() const -> Nullable<Strong> {
+      if (m_state.is_null()) [[unlikely]] {
+        return null;
+      }
+
+      /* Never resurrect an object whose last strong reference is already gone */
+      auto count = m_state->m_data_rc.load(sync::memory_order_relaxed);
+      do {
+        if (count == 0) {
+          return null;
+        }
+      } while (!m_state->m_data_rc.compare_exchange_weak(count, count + 1, sync::memory_order_acquire,
+                                                         sync::memory_order_relaxed));
+
+      return Strong(OwnPtr(m_ptr.unwrap()), OwnPtr(m_state.unwrap()));
+    }
+
+    [[nodiscard]] constexpr auto expired() const -> bool {
+      return m_state.is_null() || m_state->m_data_rc.load(sync::memory_order_relaxed) == 0;
+    }
+  };
+
+  static_assert(sizeof(ArcWeak<void>) == sizeof(void*) * 2);
 }  // namespace wesos::smartptr
@@ -9,6 +9,7 @@
 
 #include <wesos-mem/Global.hh>
 #include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-mem/StaticResource.hh>
 #include <wesos-types/NullableOwnPtr.hh>
 #include <wesos-types/Template.hh>
 
@@ -22,22 +23,27 @@ namespace wesos::smartptr {
    * also provides utility functions for accessing and managing the underlying object.
    *
    * @tparam Object The type of the object being managed by the `Box`.
+   * @tparam Resource The type of the memory resource. A concrete resource type is
+   *         called through `mem::StaticResource`, without virtual dispatch.
    */
-  template <class Object>
+  template <class Object, class Resource = mem::MemoryResourceProtocol>
   class Box {
+    template <class, class>
+    friend class Box;
+
     NullableOwnPtr<Object> m_ptr;
-    RefPtr<mem::MemoryResourceProtocol> m_mm;
+    RefPtr<Resource> m_mm;
 
     constexpr void destruct() {
       if (!m_ptr.is_null()) {
         unwrap()->~Object();
-        m_mm->deallocate_bytes(unwrap(), sizeof(Object), alignof(Object));
+        mem::StaticResource<Resource>(*m_mm).deallocate_bytes(unwrap(), sizeof(Object), alignof(Object));
 
         disown();
       }
     }
 
-    constexpr Box(OwnPtr<Object> ptr, RefPtr<mem::MemoryResourceProtocol> mm) : m_ptr(ptr), m_mm(mm) {}
+    constexpr Box(OwnPtr<Object> ptr, RefPtr<Resource> mm) : m_ptr(ptr), m_mm(mm) {}
 
   public:
     constexpr Box(const Box& o) = delete;
@@ -61,7 +67,7 @@ namespace wesos::smartptr {
      *          the same object, the source Box is disowned (its ownership is relinquished).
      */
     template <class U = Object>
-    constexpr Box(Box<U>&& o)
+    constexpr Box(Box<U, Resource>&& o)
       requires(types::is_convertible_v<U*, Object*>)
         : m_ptr(o.m_ptr), m_mm(o.m_mm) {
       if (this != &o) [[likely]] {
@@ -86,7 +92,7 @@ namespace wesos::smartptr {
      * @warning Ensure that the type `U` is convertible to `Object*` to satisfy the `requires` clause.
      */
     template <class U = Object>
-    constexpr auto operator=(Box<U>&& o) -> Box&
+    constexpr auto operator=(Box<U, Resource>&& o) -> Box&
       requires(types::is_convertible_v<U*, Object*>)
     {
       if (this != &o) [[likely]] {
@@ -117,7 +123,7 @@ namespace wesos::smartptr {
      * @return A std::strong_ordering value indicating the result of the comparison.
      */
     template <class U = Object>
-    [[nodiscard]] constexpr auto operator<=>(const Box<U>& o) const -> std::strong_ordering {
+    [[nodiscard]] constexpr auto operator<=>(const Box<U, Resource>& o) const -> std::strong_ordering {
       return unwrap() <=> o.unwrap();
     }
 
@@ -166,7 +172,7 @@ namespace wesos::smartptr {
      *
      * @return A reference to the memory resource associated with this Box.
      */
-    [[nodiscard]] constexpr auto memory_resource() -> mem::MemoryResourceProtocol& { return *m_mm; }
+    [[nodiscard]] constexpr auto memory_resource() -> Resource& { return *m_mm; }
 
     //=========================================================================================
     // POINTER ACCESS
@@ -368,8 +374,9 @@ namespace wesos::smartptr {
      * proper memory allocation and object construction, returning a nullable
      * `Box` in case of allocation failure.
      *
-     * @param mm A reference to a `mem::MemoryResourceProtocol` instance used
-     *           for memory allocation.
+     * @param mm A reference to the `Resource` instance used for memory allocation.
+     *           Defaults to the global default resource when `Resource` is the
+     *           dynamic protocol.
      *
      * @return A callable lambda function that takes variadic arguments for
      *         constructing an `Object` and returns a `Nullable<Box>`. If memory
@@ -380,9 +387,9 @@ namespace wesos::smartptr {
      *       resource protocol in smart pointers (`OwnPtr` and `RefPtr`) to
      *       ensure proper resource management.
      */
-    [[nodiscard]] static constexpr auto create(mem::MemoryResourceProtocol& mm = mem::get_default_resource()) {
+    [[nodiscard]] static constexpr auto create(Resource& mm = mem::get_default_resource()) {
       return [&mm](auto&&... args) -> Nullable<Box> {
-        const auto object_storage = mm.allocate_bytes(sizeof(Object), alignof(Object));
+        const auto object_storage = mem::StaticResource<Resource>(mm).allocate_bytes(sizeof(Object), alignof(Object));
         if (object_storage.is_null()) [[unlikely]] {
           return null;
         }
@@ -390,7 +397,7 @@ namespace wesos::smartptr {
         ::new (object_storage.unwrap()) Object(forward<decltype(args)>(args)...);
 
         const auto object_ptr = OwnPtr(static_cast<Object*>(object_storage.unwrap()));
-        const auto mm_ptr = RefPtr<mem::MemoryResourceProtocol>(&mm);
+        const auto mm_ptr = RefPtr<Resource>(&mm);
 
         return Box(object_ptr, mm_ptr);
       };
@@ -0,0 +1,210 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-mem/StaticResource.hh>
+#include <wesos-sync/Atomic.hh>
+#include <wesos-types/NullableRefPtr.hh>
+#include <wesos-types/Template.hh>
+
+namespace wesos::smartptr {
+  template <class Object, class Resource>
+  class IntrusiveArc;
+
+  /**
+   * @brief Base class that embeds the reference count of an `IntrusiveArc` in the object.
+   *
+   * Copying an object does not copy its count; the copy starts out unshared.
+   */
+  template <class Resource = mem::MemoryResourceProtocol>
+  class IntrusiveRefCount {
+    template <class, class>
+    friend class IntrusiveArc;
+
+    sync::Atomic<usize> m_ref_count = 0;
+    Resource* m_mm = nullptr;
+
+  protected:
+    constexpr IntrusiveRefCount() = default;
+    constexpr IntrusiveRefCount(const IntrusiveRefCount&) {}
+    constexpr IntrusiveRefCount(IntrusiveRefCount&&) {}
+    constexpr auto operator=(const IntrusiveRefCount&) -> IntrusiveRefCount& { return *this; }
+    constexpr auto operator=(IntrusiveRefCount&&) -> IntrusiveRefCount& { return *this; }
+    constexpr ~IntrusiveRefCount() = default;
+  };
+
+  /**
+   * @brief Atomically reference-counted pointer whose count lives inside the object.
+   *
+   * `Object` must derive from `IntrusiveRefCount<Resource>`. A handle is one pointer
+   * wide, there is no separate count block, and a clone is a single atomic increment.
+   * Because the count is reachable from the object, `from_this` can make a new handle
+   * from any plain reference to an object that is already shared.
+   */
+  template <class Object, class Resource = mem::MemoryResourceProtocol>
+  class IntrusiveArc {
+    using Hook = IntrusiveRefCount<Resource>;
+
+    NullableRefPtr<Object> m_ptr;
+
+    constexpr IntrusiveArc(OwnPtr<Object> ptr) : m_ptr(ptr) {}
+
+    [[nodiscard]] static constexpr auto hook(Object* object) -> Hook* { return static_cast<Hook*>(object); }
+    [[nodiscard]] static constexpr auto hook(const Object* object) -> const Hook* {
+      return static_cast<const Hook*>(object);
+    }
+
+    constexpr void release() {
+      if (m_ptr.is_null()) {
+        return;
+      }
+
+      auto* counted = hook(unwrap());
+      if (counted->m_ref_count.fetch_sub(1, sync::memory_order_release) == 1) [[unlikely]] {
+        sync::atomic_thread_fence(sync::memory_order_acquire);
+
+        auto& mm = *counted->m_mm;
+        unwrap()->~Object();
+        mem::StaticResource<Resource>(mm).deallocate_bytes(unwrap(), sizeof(Object), alignof(Object));
+      }
+
+      m_ptr = null;
+    }
+
+  public:
+    constexpr IntrusiveArc() = delete;
+
+    constexpr IntrusiveArc(const IntrusiveArc& o) : m_ptr(o.m_ptr) {
+      if (m_ptr.isset()) {
+        hook(unwrap())->m_ref_count.fetch_add(1, sync::memory_order_relaxed);
+      }
+    }
+
+    constexpr auto operator=(const IntrusiveArc& o) -> IntrusiveArc& {
+      if (this != &o) {
+        if (o.m_ptr.isset()) {
+          hook(o.m_ptr.unwrap())->m_ref_count.fetch_add(1, sync::memory_order_relaxed);
+        }
+
+        release();
+        m_ptr = o.m_ptr;
+      }
+
+      return *this;
+    }
+
+    constexpr IntrusiveArc(IntrusiveArc&& o) : m_ptr(o.m_ptr) { o.m_ptr = null; }
+
+    constexpr auto operator=(IntrusiveArc&& o) -> IntrusiveArc& {
+      if (this != &o) {
+        release();
+        m_ptr = o.m_ptr;
+        o.m_ptr = null;
+      }
+
+      return *this;
+    }
+
+    constexpr ~IntrusiveArc() { release(); }
+
+    [[nodiscard]] constexpr auto operator<=>(const IntrusiveArc& o) const { return unwrap() <=> o.unwrap(); }
+    [[nodiscard]] constexpr auto operator==(types::Null) const { return is_null(); }
+    [[nodiscard]] constexpr auto operator==(types::nullptr_t) const { return is_null(); }
+
+    [[nodiscard]] static constexpr auto min_alloc_size() -> usize { return sizeof(Object); }
+    [[nodiscard]] static constexpr auto min_alloc_alignment() -> PowerOfTwo<usize> { return alignof(Object); }
+
+    template <class... Args>
+    [[nodiscard]] static constexpr auto create(Resource& mm, Args&&... args) -> Nullable<IntrusiveArc>
+      requires(types::is_base_of_v<Hook, Object>)
+    {
+      const auto storage = mem::StaticResource<Resource>(mm).allocate_bytes(sizeof(Object), alignof(Object));
+      if (storage.is_null()) [[unlikely]] {
+        return null;
+      }
+
+      auto* object = ::new (storage.unwrap()) Object(forward<Args>(args)...);
+      hook(object)->m_mm = &mm;
+      hook(object)->m_ref_count.store(1, sync::memory_order_relaxed);
+
+      return IntrusiveArc(OwnPtr(object));
+    }
+
+    /**
+     * @brief Make another handle to an object that is already owned by an `IntrusiveArc`.
+     *
+     * The caller must hold a handle (directly or further up the call chain) for as
+     * long as this runs, so the count cannot reach zero underneath it.
+     */
+    [[nodiscard]] static constexpr auto from_this(Object& object) -> IntrusiveArc {
+      const auto previous = hook(&object)->m_ref_count.fetch_add(1, sync::memory_order_relaxed);
+      assert_always(previous != 0);
+
+      return IntrusiveArc(OwnPtr(&object));
+    }
+
+    //=========================================================================================
+    // LIFETIME MANAGEMENT
+    //=========================================================================================
+
+    [[nodiscard]] constexpr auto ref_count() const -> usize {
+      return m_ptr.isset() ? hook(unwrap())->m_ref_count.load(sync::memory_order_relaxed) : 0;
+    }
+
+    //=========================================================================================
+    // POINTER ACCESS
+    //=========================================================================================
+
+    [[nodiscard]] constexpr auto unwrap() -> Object* { return m_ptr.unwrap(); }
+    [[nodiscard]] constexpr auto unwrap() const -> const Object* { return m_ptr.unwrap(); }
+
+    [[nodiscard]] constexpr auto isset() const -> bool { return m_ptr.isset(); }
+    [[nodiscard]] constexpr auto is_null() const -> bool { return m_ptr.is_null(); }
+
+    [[nodiscard]] constexpr auto operator->() -> Object* {
+      assert_always(m_ptr.isset());
+      return unwrap();
+    };
+
+    [[nodiscard]] constexpr auto operator->() const -> const Object* {
+      assert_always(m_ptr.isset());
+      return unwrap();
+    };
+
+    [[nodiscard]] constexpr auto operator*() -> Object& {
+      assert_always(m_ptr.isset());
+      return *unwrap();
+    };
+
+    [[nodiscard]] constexpr auto operator*() const -> const Object& {
+      assert_always(m_ptr.isset());
+      return *unwrap();
+    };
+
+    [[nodiscard]] constexpr auto get() -> Object& {
+      assert_always(m_ptr.isset());
+      return *unwrap();
+    };
+
+    [[nodiscard]] constexpr auto get() const -> const Object& {
+      assert_always(m_ptr.isset());
+      return *unwrap();
+    };
+
+    [[nodiscard]] constexpr auto get_unchecked() -> Object& {
+      assert_invariant(m_ptr.isset());
+      return *unwrap();
+    };
+
+    [[nodiscard]] constexpr auto get_unchecked() const -> const Object& {
+      assert_invariant(m_ptr.isset());
+      return *unwrap();
+    };
+  };
+}  // namespace wesos::smartptr
@@ -0,0 +1,260 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-cpu/PerCpu.hh>
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-mem/StaticResource.hh>
+#include <wesos-sync/Atomic.hh>
+#include <wesos-types/NullableRefPtr.hh>
+#include <wesos-types/Template.hh>
+
+namespace wesos::smartptr {
+  /**
+   * @brief Reference-counted pointer with per-CPU counters, for objects that every CPU clones constantly.
+   *
+   * While the object is live, a clone or a drop only touches the calling CPU's
+   * counter, so no cache line bounces between CPUs. Counters may go negative (clone
+   * on one CPU, drop on another); only their sum means anything, so nothing can
+   * notice the count reaching zero in this mode.
+   *
+   * Teardown starts when one handle calls `kill`. The per-CPU counters are then
+   * collapsed into a single shared atomic, and that handle is dropped. From then on
+   * every clone and drop goes to the shared atomic, and the last drop destroys the
+   * object.
+   *
+   * Each object carries `cpu::MAX_CPUS` cache lines of counters. That suits a few
+   * long-lived, very hot objects, not everything.
+   *
+   * @warning Every clone and drop reads `cpu::current_cpu_hint`, which costs an
+   * `rdtscp`. A single-threaded clone/drop is about 3x slower than `Arc` (69 ns
+   * against 20 ns in `bench-libwesos-smartptr`). Until the kernel registers every
+   * CPU with `cpu::register_cpu`, the hint is always 0, so all CPUs share one
+   * counter and it does not scale any better than `Arc` either. Keep it out of
+   * kernel hot paths until then; use `Arc` instead.
+   */
+  template <class Object, class Resource = mem::MemoryResourceProtocol>
+  class PerCpuArc {
+    /* A collapsed slot; the sentinel can never be reached by counting */
+    static constexpr isize DEAD = isize(usize(1) << (sizeof(isize) * 8 - 1));
+
+    /* Keeps the shared count off zero while the slots are being collapsed */
+    static constexpr isize COLLAPSE_BIAS = isize(usize(1) << (sizeof(isize) * 8 - 2));
+
+    struct State {
+      cpu::PerCpu<sync::Atomic<isize>> m_local_rc;
+      alignas(cpu::CACHE_LINE_SIZE) sync::Atomic<isize> m_shared_rc = 0;
+      Resource& m_mm;
+
+      constexpr State(Resource& mm) : m_mm(mm) {}
+    };
+
+    NullableRefPtr<State> m_state;
+
+    constexpr PerCpuArc(OwnPtr<State> state) : m_state(state) {}
+
+    [[nodiscard]] static constexpr auto object_offset() -> usize {
+      return (sizeof(State) + alignof(Object) - 1) & ~(alignof(Object) - 1);
+    }
+
+    [[nodiscard]] static constexpr auto block_size() -> usize { return object_offset() + sizeof(Object); }
+
+    [[nodiscard]] static constexpr auto block_alignment() -> PowerOfTwo<usize> {
+      return max(alignof(State), alignof(Object));
+    }
+
+    /* Returns false once the local slot has been collapsed */
+    [[nodiscard]] static auto add_local(State& state, isize delta, sync::MemoryOrder order) -> bool {
+      auto& slot = state.m_local_rc.local();
+
+      auto count = slot.load(sync::memory_order_relaxed);
+      do {
+        if (count == DEAD) [[unlikely]] {
+          return false;
+        }
+      } while (!slot.compare_exchange_weak(count, count + delta, order, sync::memory_order_relaxed));
+
+      return true;
+    }
+
+    static void retain(State& state) {
+      if (!add_local(state, 1, sync::memory_order_relaxed)) [[unlikely]] {
+        state.m_shared_rc.fetch_add(1, sync::memory_order_relaxed);
+      }
+    }
+
+    constexpr void release() {
+      if (m_state.is_null()) {
+        return;
+      }
+
+      auto& state = *m_state.unwrap();
+      m_state = null;
+
+      if (add_local(state, -1, sync::memory_order_release)) [[likely]] {
+        return;
+      }
+
+      if (state.m_shared_rc.fetch_sub(1, sync::memory_order_release) == 1) [[unlikely]] {
+        sync::atomic_thread_fence(sync::memory_order_acquire);
+
+        auto resource = mem::StaticResource<Resource>(state.m_mm);
+        auto* block = bit_cast<u8*>(&state);
+
+        bit_cast<Object*>(block + object_offset())->~Object();
+        state.~State();
+        resource.deallocate_bytes(block, block_size(), block_alignment());
+      }
+    }
+
+  public:
+    constexpr PerCpuArc() = delete;
+
+    constexpr PerCpuArc(const PerCpuArc& o) : m_state(o.m_state) {
+      if (m_state.isset()) {
+        retain(*m_state.unwrap());
+      }
+    }
+
+    constexpr auto operator=(const PerCpuArc& o) -> PerCpuArc& {
+      if (this != &o) {
+        if (o.m_state.isset()) {
+          retain(*o.m_state.unwrap());
+        }
+
+        release();
+        m_state = o.m_state;
+      }
+
+      return *this;
+    }
+
+    constexpr PerCpuArc(PerCpuArc&& o) : m_state(o.m_state) { o.m_state = null; }
+
+    constexpr auto operator=(PerCpuArc&& o) -> PerCpuArc& {
+      if (this != &o) {
+        release();
+        m_state = o.m_state;
+        o.m_state = null;
+      }
+
+      return *this;
+    }
+
+    constexpr ~PerCpuArc() { release(); }
+
+    [[nodiscard]] constexpr auto operator<=>(const PerCpuArc& o) const { return unwrap() <=> o.unwrap(); }
+    [[nodiscard]] constexpr auto operator==(types::Null) const { return is_null(); }
+    [[nodiscard]] constexpr auto operator==(types::nullptr_t) const { return is_null(); }
+
+    [[nodiscard]] static constexpr auto min_alloc_size() -> usize { return block_size(); }
+    [[nodiscard]] static constexpr auto min_alloc_alignment() -> PowerOfTwo<usize> { return block_alignment(); }
+
+    template <class... Args>
+    [[nodiscard]] static constexpr auto create(Resource& mm, Args&&... args) -> Nullable<PerCpuArc> {
+      const auto storage = mem::StaticResource<Resource>(mm).allocate_bytes(block_size(), block_alignment());
+      if (storage.is_null()) [[unlikely]] {
+        return null;
+      }
+
+      auto* block = static_cast<u8*>(storage.unwrap());
+      auto* state = ::new (block) State(mm);
+      ::new (block + object_offset()) Object(forward<Args>(args)...);
+
+      /* The first handle is counted in the shared atomic, which no CPU touches until teardown */
+      state->m_shared_rc.store(1, sync::memory_order_relaxed);
+
+      return PerCpuArc(OwnPtr(state));
+    }
+
+    //=========================================================================================
+    // LIFETIME MANAGEMENT
+    //=========================================================================================
+
+    /**
+     * @brief Switch to a single shared count and drop this handle.
+     *
+     * Must be called exactly once per object, by whichever handle owns its teardown.
+     * The object is destroyed when the last remaining handle drops.
+     */
+    void kill() {
+      assert_always(m_state.isset());
+
+      auto& state = *m_state.unwrap();
+      state.m_shared_rc.fetch_add(COLLAPSE_BIAS, sync::memory_order_relaxed);
+
+      isize sum = 0;
+      state.m_local_rc.for_each([&](sync::Atomic<isize>& slot) {
+        const auto count = slot.exchange(DEAD, sync::memory_order_acq_rel);
+        assert_always(count != DEAD);
+        sum += count;
+      });
+
+      state.m_shared_rc.fetch_add(sum - COLLAPSE_BIAS, sync::memory_order_relaxed);
+
+      release();
+    }
+
+    /**
+     * @brief Number of live handles, or null while the counts are still per-CPU.
+     */
+    [[nodiscard]] auto ref_count() const -> Nullable<usize> {
+      if (m_state.is_null() || m_state->m_local_rc.get(0).load(sync::memory_order_relaxed) != DEAD) {
+        return null;
+      }
+
+      return usize(m_state->m_shared_rc.load(sync::memory_order_relaxed));
+    }
+
+    //=========================================================================================
+    // POINTER ACCESS
+    //=========================================================================================
+
+    [[nodiscard]] constexpr auto unwrap() -> Object* {
+      return m_state.isset() ? bit_cast<Object*>(bit_cast<u8*>(m_state.unwrap()) + object_offset()) : nullptr;
+    }
+
+    [[nodiscard]] constexpr auto unwrap() const -> const Object* {
+      return m_state.isset() ? bit_cast<const Object*>(bit_cast<const u8*>(m_state.unwrap()) + object_offset())
+                             : nullptr;
+    }
+
+    [[nodiscard]] constexpr auto isset() const -> bool { return m_state.isset(); }
+    [[nodiscard]] constexpr auto is_null() const -> bool { return m_state.is_null(); }
+
+    [[nodiscard]] constexpr auto operator->() -> Object* {
+      assert_always(m_state.isset());
+      return unwrap();
+    };
+
+    [[nodiscard]] constexpr auto operator->() const -> const Object* {
+      assert_always(m_state.isset());
+      return unwrap();
+    };
+
+    [[nodiscard]] constexpr auto operator*() -> Object& {
+      assert_always(m_state.isset());
+      return *unwrap();
+    };
+
+    [[nodiscard]] constexpr auto operator*() const -> const Object& {
+      assert_always(m_state.isset());
+      return *unwrap();
+    };
+
+    [[nodiscard]] constexpr auto get() -> Object& {
+      assert_always(m_state.isset());
+      return *unwrap();
+    };
+
+    [[nodiscard]] constexpr auto get() const -> const Object& {
+      assert_always(m_state.isset());
+      return *unwrap();
+    };
+  };
+}  // namespace wesos::smartptr
@@ -8,24 +8,62 @@
 #pragma once
 
 #include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-mem/StaticResource.hh>
 #include <wesos-types/NullableRefPtr.hh>
 #include <wesos-types/Template.hh>
 
 namespace wesos::smartptr {
-  template <class Object>
+  template <class Object, class Resource>
+  class RcWeak;
+
+  /**
+   * @brief Reference-counted pointer for use on a single CPU.
+   *
+   * All strong references together hold one count on the state block. `downgrade`
+   * hands out an `RcWeak`, which counts only on the state block. The object and its
+   * memory go away with the last strong reference; the small state block stays until
+   * the last weak reference drops too.
+   */
+  template <class Object, class Resource = mem::MemoryResourceProtocol>
   class Rc {
+    friend class RcWeak<Object, Resource>;
+
     struct State {
       usize m_state_rc = 1;
       usize m_data_rc = 1;
-      mem::MemoryResourceProtocol& m_mm;
+      Resource& m_mm;
 
-      constexpr State(mem::MemoryResourceProtocol& mm) : m_mm(mm) {}
+      constexpr State(Resource& mm) : m_mm(mm) {}
     };
 
     NullableRefPtr<Object> m_ptr;
     NullableRefPtr<State> m_state;
 
-    // constexpr Rc(OwnPtr<Object> ptr, OwnPtr<State> state) : m_ptr(ptr), m_state(state) {}
+    constexpr Rc(OwnPtr<Object> ptr, OwnPtr<State> state) : m_ptr(ptr), m_state(state) {}
+
+    static constexpr void drop_state(State* state) {
+      if (--state->m_state_rc == 0) [[unlikely]] {
+        auto& mm = state->m_mm;
+        state->~State();
+        mem::StaticResource<Resource>(mm).deallocate_bytes(state, sizeof(State), alignof(State));
+      }
+    }
+
+    constexpr void release() {
+      if (m_state.is_null()) {
+        return;
+      }
+
+      if (--m_state->m_data_rc == 0) [[unlikely]] {
+        unwrap()->~Object();
+        mem::StaticResource<Resource>(m_state->m_mm).deallocate_bytes(unwrap(), sizeof(Object), alignof(Object));
+
+        drop_state(m_state.unwrap());
+      }
+
+      m_ptr = null;
+      m_state = null;
+    }
 
   public:
     constexpr Rc() = delete;
@@ -33,17 +71,21 @@ namespace wesos::smartptr {
     constexpr Rc(const Rc& o) : m_ptr(o.m_ptr), m_state(o.m_state) {
       assert_invariant(m_state.isset());
 
-      ++m_state->m_state_rc;
       ++m_state->m_data_rc;
     }
 
     constexpr auto operator=(const Rc& o) -> Rc& {
-      assert_invariant(m_state.isset());
+      assert_invariant(o.m_state.isset());
 
-      m_ptr = o.m_ptr;
-      m_state = o.m_state;
-      ++m_state->m_state_rc;
-      ++m_state->m_data_rc;
+      if (this != &o) {
+        ++o.m_state->m_data_rc;
+
+        release();
+        m_ptr = o.m_ptr;
+        m_state = o.m_state;
+      }
+
+      return *this;
     }
 
     constexpr Rc(Rc&& o) : m_ptr(o.m_ptr), m_state(o.m_state) {
@@ -52,27 +94,18 @@ namespace wesos::smartptr {
     }
 
     constexpr auto operator=(Rc&& o) -> Rc& {
-      m_ptr = o.m_ptr;
-      m_state = o.m_state;
-      o.m_ptr = null;
-      o.m_state = null;
-    };
+      if (this != &o) {
+        release();
+        m_ptr = o.m_ptr;
+        m_state = o.m_state;
+        o.m_ptr = null;
+        o.m_state = null;
+      }
 
-    constexpr ~Rc() {
-      if (m_state.isset()) {
-        if (m_ptr.isset() && --m_state->m_data_rc == 0) [[unlikely]] {
-          auto& mm = m_state->m_mm;
-          unwrap()->~Object();
-          mm.deallocate_bytes(unwrap(), sizeof(Object), alignof(Object));
-        }
+      return *this;
+    };
 
-        if (--m_state->m_state_rc == 0) [[unlikely]] {
-          auto& mm = m_state->m_mm;
-          m_state.unwrap()->~State();
-          mm.deallocate_bytes(m_state.unwrap(), sizeof(State), alignof(State));
-        }
-      }
-    }
+    constexpr ~Rc() { release(); }
 
     [[nodiscard]] constexpr auto operator<=>(const Rc& o) const { return unwrap() <=> o.unwrap(); }
     [[nodiscard]] constexpr auto operator==(types::Null) const { return is_null(); }
@@ -85,14 +118,17 @@ namespace wesos::smartptr {
     }
 
     template <class... Args>
-    [[nodiscard]] static constexpr auto create(mem::MemoryResourceProtocol& mm, Args&&... args) -> Nullable<Rc> {
-      const auto object_storage = mm.allocate_bytes(sizeof(Object), alignof(Object));
+    [[nodiscard]] static constexpr auto create(Resource& mm, Args&&... args) -> Nullable<Rc> {
+      auto resource = mem::StaticResource<Resource>(mm);
+
+      const auto object_storage = resource.allocate_bytes(sizeof(Object), alignof(Object));
       if (object_storage.is_null()) [[unlikely]] {
         return null;
       }
 
-      const auto state_storage = mm.allocate_bytes(sizeof(State), alignof(State));
+      const auto state_storage = resource.allocate_bytes(sizeof(State), alignof(State));
       if (state_storage.is_null()) [[unlikely]] {
+        resource.deallocate_bytes(object_storage, sizeof(Object), alignof(Object));
         return null;
       }
 
@@ -111,6 +147,13 @@ namespace wesos::smartptr {
 
     [[nodiscard]] constexpr auto ref_count() const -> usize { return m_state.isset() ? m_state->m_data_rc : 0; }
 
+    [[nodiscard]] constexpr auto downgrade() const -> RcWeak<Object, Resource> {
+      assert_always(m_state.isset());
+
+      ++m_state->m_state_rc;
+      return RcWeak<Object, Resource>(OwnPtr(m_ptr.unwrap()), OwnPtr(m_state.unwrap()));
+    }
+
     //=========================================================================================
     // POINTER ACCESS
     //=========================================================================================
@@ -171,4 +214,87 @@ namespace wesos::smartptr {
   };
 
   static_assert(sizeof(Rc<void>) == sizeof(void*) * 2);
+
+  /**
+   * @brief Non-owning handle to an object managed by `Rc`.
+   *
+   * `upgrade` returns a new strong reference while the object is still alive, and
+   * null after the last strong reference has dropped.
+   */
+  template <class Object, class Resource = mem::MemoryResourceProtocol>
+  class RcWeak {
+    friend class Rc<Object, Resource>;
+
+    using Strong = Rc<Object, Resource>;
+    using State = typename Strong::State;
+
+    NullableRefPtr<Object> m_ptr;
+    NullableRefPtr<State> m_state;
+
+    constexpr RcWeak(OwnPtr<Object> ptr, OwnPtr<State> state) : m_ptr(ptr), m_state(state) {}
+
+    constexpr void release() {
+      if (m_state.isset()) {
+        Strong::drop_state(m_state.unwrap());
+      }
+
+      m_ptr = null;
+      m_state = null;
+    }
+
+  public:
+    constexpr RcWeak() = delete;
+
+    constexpr RcWeak(const RcWeak& o) : m_ptr(o.m_ptr), m_state(o.m_state) {
+      if (m_state.isset()) {
+        ++m_state->m_state_rc;
+      }
+    }
+
+    constexpr auto operator=(const RcWeak& o) -> RcWeak& {
+      if (this != &o) {
+        if (o.m_state.isset()) {
+          ++o.m_state->m_state_rc;
+        }
+
+        release();
+        m_ptr = o.m_ptr;
+        m_state = o.m_state;
+      }
+
+      return *this;
+    }
+
+    constexpr RcWeak(RcWeak&& o) : m_ptr(o.m_ptr), m_state(o.m_state) {
+      o.m_ptr = null;
+      o.m_state = null;
+    }
+
+    constexpr auto operator=(RcWeak&& o) -> RcWeak& {
+      if (this != &o) {
+        release();
+        m_ptr = o.m_ptr;
+        m_state = o.m_state;
+        o.m_ptr = null;
+        o.m_state = null;
+      }
+
+      return *this;
+    }
+
+    constexpr ~RcWeak() { release(); }
+
+    [[nodiscard]] constexpr auto upgrade() const -> Nullable<Strong> {
+      if (expired()) {
+        return null;
+      }
+
+      ++m_state->m_data_rc;
+      return Strong(OwnPtr(m_ptr.unwrap()), OwnPtr(m_state.unwrap()));
+    }
+
+    [[nodiscard]] constexpr auto expired() const -> bool { return m_state.is_null() || m_state->m_data_rc == 0; }
+  };
+
+  static_assert(sizeof(RcWeak<void>) == sizeof(void*) * 2);
 }  // namespace wesos::smartptr
@@ -0,0 +1,190 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-mem/Global.hh>
+#include <wesos-mem/MemoryResourceProtocol.hh>
+#include <wesos-mem/StaticResource.hh>
+#include <wesos-types/NullableOwnPtr.hh>
+#include <wesos-types/Template.hh>
+
+namespace wesos::smartptr {
+  /**
+   * @brief Resource provider that hands out `mem::get_default_resource()`.
+   *
+   * A provider is any type with a static `resource()` that returns a reference to a
+   * memory resource. The reference must stay valid for as long as boxes exist.
+   */
+  struct DefaultResourceProvider {
+    [[nodiscard]] static auto resource() -> mem::MemoryResourceProtocol& { return mem::get_default_resource(); }
+  };
+
+  /**
+   * @class StaticBox
+   * @brief A `Box` whose memory resource is fixed by its type, so the handle is a single pointer.
+   *
+   * `Box` carries a pointer to its resource in every handle. When all objects of a
+   * type come from the same resource, that pointer is wasted space. `StaticBox` gets
+   * the resource from `Provider::resource()` instead. If the provider returns a
+   * concrete resource type, calls go through `mem::StaticResource` without virtual
+   * dispatch.
+   *
+   * Use `Box` when different instances need different resources.
+   *
+   * @tparam Object The type of the object being managed.
+   * @tparam Provider A type with a static `resource()` member, such as `DefaultResourceProvider`.
+   */
+  template <class Object, class Provider = DefaultResourceProvider>
+  class StaticBox {
+    template <class, class>
+    friend class StaticBox;
+
+    using Resource = types::remove_reference_t<decltype(Provider::resource())>;
+
+    NullableOwnPtr<Object> m_ptr;
+
+    constexpr void destruct() {
+      if (!m_ptr.is_null()) {
+        unwrap()->~Object();
+        mem::StaticResource<Resource>(Provider::resource()).deallocate_bytes(unwrap(), sizeof(Object), alignof(Object));
+
+        m_ptr = null;
+      }
+    }
+
+    constexpr StaticBox(OwnPtr<Object> ptr) : m_ptr(ptr) {}
+
+  public:
+    constexpr StaticBox(const StaticBox& o) = delete;
+    constexpr auto operator=(const StaticBox& o) -> StaticBox& = delete;
+
+    template <class U = Object>
+    constexpr StaticBox(StaticBox<U, Provider>&& o)
+      requires(types::is_convertible_v<U*, Object*>)
+        : m_ptr(o.m_ptr) {
+      o.m_ptr = null;
+    }
+
+    template <class U = Object>
+    constexpr auto operator=(StaticBox<U, Provider>&& o) -> StaticBox&
+      requires(types::is_convertible_v<U*, Object*>)
+    {
+      if (this != &o) [[likely]] {
+        destruct();
+
+        m_ptr = o.m_ptr;
+        o.m_ptr = null;
+      }
+
+      return *this;
+    }
+
+    constexpr ~StaticBox() { destruct(); }
+
+    template <class U = Object>
+    [[nodiscard]] constexpr auto operator<=>(const StaticBox<U, Provider>& o) const -> std::strong_ordering {
+      return unwrap() <=> o.unwrap();
+    }
+
+    [[nodiscard]] constexpr auto operator==(types::Null) const { return is_null(); }
+    [[nodiscard]] constexpr auto operator==(types::nullptr_t) const { return is_null(); }
+
+    /**
+     * @brief Allocates from the provider's resource and constructs an `Object` in place.
+     * @return The new box, or null if the allocation failed.
+     */
+    template <class... Args>
+    [[nodiscard]] static constexpr auto create(Args&&... args) -> Nullable<StaticBox> {
+      const auto object_storage =
+          mem::StaticResource<Resource>(Provider::resource()).allocate_bytes(sizeof(Object), alignof(Object));
+      if (object_storage.is_null()) [[unlikely]] {
+        return null;
+      }
+
+      ::new (object_storage.unwrap()) Object(forward<Args>(args)...);
+
+      return StaticBox(OwnPtr(static_cast<Object*>(object_storage.unwrap())));
+    }
+
+    //=========================================================================================
+    // LIFETIME MANAGEMENT
+    //=========================================================================================
+
+    /**
+     * @brief Releases ownership of the managed object and returns a raw pointer to it.
+     * @note The caller must destroy the object and return its memory to `Provider::resource()`.
+     */
+    constexpr auto disown() -> Object* {
+      auto* object = unwrap();
+      m_ptr = null;
+      return object;
+    }
+
+    [[nodiscard]] static constexpr auto memory_resource() -> Resource& { return Provider::resource(); }
+
+    //=========================================================================================
+    // POINTER ACCESS
+    //=========================================================================================
+
+    [[nodiscard]] constexpr auto unwrap() -> Object* { return m_ptr.unwrap(); }
+    [[nodiscard]] constexpr auto unwrap() const -> const Object* { return m_ptr.unwrap(); }
+
+    [[nodiscard]] constexpr auto isset() const -> bool { return m_ptr.isset(); }
+    [[nodiscard]] constexpr auto is_null() const -> bool { return m_ptr.is_null(); }
+
+    template <class U = Object>
+    [[nodiscard]] constexpr auto operator->() -> U* requires(!types::is_same_v<U, void>) {
+      assert_always(m_ptr.isset());
+      return unwrap();
+    };
+
+    template <class U = Object>
+    [[nodiscard]] constexpr auto operator->() const -> const U* requires(!types::is_same_v<U, void>) {
+      assert_always(m_ptr.isset());
+      return unwrap();
+    };
+
+    template <class U = Object>
+    [[nodiscard]] constexpr auto operator*() -> U& requires(!types::is_same_v<U, void>) {
+      assert_always(m_ptr.isset());
+      return *unwrap();
+    };
+
+    template <class U = Object>
+    [[nodiscard]] constexpr auto operator*() const -> const U& requires(!types::is_same_v<U, void>) {
+      assert_always(m_ptr.isset());
+      return *unwrap();
+    };
+
+    template <class U = Object>
+    [[nodiscard]] constexpr auto get() -> U& requires(!types::is_same_v<U, void>) {
+      assert_always(m_ptr.isset());
+      return *unwrap();
+    };
+
+    template <class U = Object>
+    [[nodiscard]] constexpr auto get() const -> const U& requires(!types::is_same_v<U, void>) {
+      assert_always(m_ptr.isset());
+      return *unwrap();
+    };
+
+    template <class U = Object>
+    [[nodiscard]] constexpr auto get_unchecked() -> U& requires(!types::is_same_v<U, void>) {
+      assert_invariant(m_ptr.isset());
+      return *unwrap();
+    };
+
+    template <class U = Object>
+    [[nodiscard]] constexpr auto get_unchecked() const -> const U& requires(!types::is_same_v<U, void>) {
+      assert_invariant(m_ptr.isset());
+      return *unwrap();
+    };
+  };
+
+  static_assert(sizeof(StaticBox<void>) == sizeof(void*));
+}  // namespace wesos::smartptr
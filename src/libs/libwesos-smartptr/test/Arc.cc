@@ -7,6 +7,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+#include <wesos-alloc/IntrusivePool.hh>
 #include <wesos-smartptr/Arc.hh>
 
 #include "Helper.hh"
@@ -15,6 +17,125 @@ using namespace wesos;
 using namespace wesos::smartptr;
 
 TEST(wesos_smartptr, Arc) {
-  // TODO: Implement the test for Arc
-  FAIL() << "Not implemented yet";
+  using Shared = Arc<SemanticCounter, alloc::IntrusivePool>;
+
+  /* One pool object per Arc proves the count block and the object share an allocation */
+  std::vector<u8> storage(Shared::min_alloc_size() * 2);
+  auto pool = alloc::IntrusivePool(Shared::min_alloc_size(), Shared::min_alloc_alignment(),
+                                   View<u8>(storage.data(), storage.size()));
+
+  usize constructed = 0;
+  usize moved = 0;
+  usize copied = 0;
+  usize destructed = 0;
+
+  {
+    auto arc = Shared::create(pool, constructed, moved, copied, destructed);
+    ASSERT_TRUE(arc);
+    ASSERT_EQ(arc->ref_count(), 1);
+
+    auto clone = arc.value();
+    ASSERT_EQ(clone.ref_count(), 2);
+    ASSERT_EQ(clone.unwrap(), arc->unwrap());
+
+    auto other = Shared::create(pool, constructed, moved, copied, destructed);
+    ASSERT_TRUE(other);
+    ASSERT_FALSE(Shared::create(pool, constructed, moved, copied, destructed));
+
+    /* Copy assignment must let go of the previous object */
+    other.value() = clone;
+    ASSERT_EQ(destructed, 1);
+    ASSERT_EQ(clone.ref_count(), 3);
+
+    auto moved_arc = std::move(clone);
+    ASSERT_EQ(moved_arc.ref_count(), 3);
+    ASSERT_TRUE(clone.is_null());
+
+    ASSERT_TRUE(Shared::create(pool, constructed, moved, copied, destructed));
+  }
+
+  ASSERT_EQ(constructed, 3);
+  ASSERT_EQ(moved, 0);
+  ASSERT_EQ(copied, 0);
+  ASSERT_EQ(destructed, 3);
+}
+
+TEST(wesos_smartptr, Arc_Adopt) {
+  using Shared = Arc<SemanticCounter, alloc::IntrusivePool>;
+
+  constexpr usize object_size = max(sizeof(SemanticCounter), Shared::min_alloc_size());
+
+  std::vector<u8> storage(object_size * 2);
+  auto pool = alloc::IntrusivePool(object_size, alignof(SemanticCounter), View<u8>(storage.data(), storage.size()));
+
+  usize constructed = 0;
+  usize moved = 0;
+  usize copied = 0;
+  usize destructed = 0;
+
+  {
+    auto object_storage = pool.allocate_bytes(sizeof(SemanticCounter), alignof(SemanticCounter));
+    ASSERT_TRUE(object_storage.isset());
+
+    auto* object = ::new (object_storage.unwrap()) SemanticCounter(constructed, moved, copied, destructed);
+
+    auto arc = Shared::adopt(pool, object);
+    ASSERT_TRUE(arc);
+    ASSERT_EQ(arc->unwrap(), object);
+
+    auto clone = arc.value();
+    ASSERT_EQ(clone.ref_count(), 2);
+
+    /* Both the object and its count block are in use */
+    ASSERT_FALSE(pool.allocate_bytes(sizeof(SemanticCounter), alignof(SemanticCounter)).isset());
+  }
+
+  ASSERT_EQ(constructed, 1);
+  ASSERT_EQ(destructed, 1);
+
+  auto first = pool.allocate_bytes(sizeof(SemanticCounter), alignof(SemanticCounter));
+  auto second = pool.allocate_bytes(sizeof(SemanticCounter), alignof(SemanticCounter));
+  ASSERT_TRUE(first.isset() && second.isset());
+}
+
+TEST(wesos_smartptr, Arc_Weak) {
+  using Shared = Arc<SemanticCounter, alloc::IntrusivePool>;
+
+  std::vector<u8> storage(Shared::min_alloc_size());
+  auto pool = alloc::IntrusivePool(Shared::min_alloc_size(), Shared::min_alloc_alignment(),
+                                   View<u8>(storage.data(), storage.size()));
+
+  usize constructed = 0;
+  usize moved = 0;
+  usize copied = 0;
+  usize destructed = 0;
+
+  auto weak = [&] {
+    auto arc = Shared::create(pool, constructed, moved, copied, destructed);
+    EXPECT_TRUE(arc);
+
+    auto weak = arc->downgrade();
+    auto weak_clone = weak;
+    EXPECT_FALSE(weak_clone.expired());
+
+    auto upgraded = weak_clone.upgrade();
+    EXPECT_TRUE(upgraded);
+    EXPECT_EQ(upgraded->unwrap(), arc->unwrap());
+    EXPECT_EQ(arc->ref_count(), 2);
+
+    return weak;
+  }();
+
+  /* The object is gone, but the inline block stays until the last weak reference drops */
+  ASSERT_EQ(destructed, 1);
+  ASSERT_TRUE(weak.expired());
+  ASSERT_FALSE(weak.upgrade());
+  ASSERT_FALSE(Shared::create(pool, constructed, moved, copied, destructed));
+
+  {
+    auto last = std::move(weak);
+  }
+
+  ASSERT_TRUE(Shared::create(pool, constructed, moved, copied, destructed));
+  ASSERT_EQ(constructed, 2);
 }
@@ -7,7 +7,10 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #define WESOS_MEM_INITIALIZE_WITH_MALLOC
+#include <wesos-alloc/IntrusivePool.hh>
 #include <wesos-mem/Memory.hh>
 #include <wesos-smartptr/Box.hh>
 
@@ -17,9 +20,13 @@ using namespace wesos;
 using namespace wesos::smartptr;
 
 TEST(wesos_smartptr, Box) {
-  auto init_status = mem::initialize_with_malloc();
-  ASSERT_TRUE(init_status);
-  auto _ = defer([&]() { std::free(init_status->unwrap()); });
+  /* The buffer belongs to the default resource from now on, so it is never freed */
+  static const bool initialized = mem::initialize_with_malloc().isset();
+  ASSERT_TRUE(initialized);
+
+  // Only the first initialization counts; later buffers are left alone
+  Array<u8, mem::Kickstart::MINIMUM_INITIALIZATION_SIZE> spare;
+  ASSERT_FALSE(mem::initialize(mem::Kickstart(spare.into_ptr().unwrap(), spare.length())));
 
   usize constructed = 0;
   usize moved = 0;
@@ -48,3 +55,32 @@ TEST(wesos_smartptr, Box) {
   ASSERT_EQ(copied, 0);
   ASSERT_EQ(destructed, 1);
 }
+
+TEST(wesos_smartptr, Box_StaticResource) {
+  std::vector<u8> storage(sizeof(SemanticCounter) * 2);
+  auto pool = alloc::IntrusivePool(sizeof(SemanticCounter), alignof(SemanticCounter),
+                                   View<u8>(storage.data(), storage.size()));
+
+  usize constructed = 0;
+  usize moved = 0;
+  usize copied = 0;
+  usize destructed = 0;
+
+  {
+    auto box = Box<SemanticCounter, alloc::IntrusivePool>::create(pool)(constructed, moved, copied, destructed);
+    ASSERT_TRUE(box);
+    ASSERT_EQ(&box.value().memory_resource(), &pool);
+
+    auto box2 = Box<SemanticCounter, alloc::IntrusivePool>::create(pool)(constructed, moved, copied, destructed);
+    ASSERT_TRUE(box2);
+
+    auto box3 = Box<SemanticCounter, alloc::IntrusivePool>::create(pool)(constructed, moved, copied, destructed);
+    ASSERT_FALSE(box3);
+  }
+
+  ASSERT_EQ(constructed, 2);
+  ASSERT_EQ(destructed, 2);
+
+  auto box = Box<SemanticCounter, alloc::IntrusivePool>::create(pool)(constructed, moved, copied, destructed);
+  ASSERT_TRUE(box);
+}
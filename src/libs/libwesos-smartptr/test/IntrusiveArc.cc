@@ -0,0 +1,111 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+#include <wesos-alloc/AtomicIntrusivePool.hh>
+#include <wesos-alloc/IntrusivePool.hh>
+#include <wesos-smartptr/IntrusiveArc.hh>
+
+#include "Helper.hh"
+
+using namespace wesos;
+using namespace wesos::smartptr;
+
+namespace {
+  class CountedObject final : public IntrusiveRefCount<alloc::IntrusivePool> {
+    SemanticCounter m_counter;
+
+  public:
+    CountedObject(usize& constructed, usize& moved, usize& copied, usize& destructed)
+        : m_counter(constructed, moved, copied, destructed) {}
+  };
+
+  class ThreadedObject final : public IntrusiveRefCount<alloc::AtomicIntrusivePool> {
+  public:
+    usize m_value = 0;
+  };
+}  // namespace
+
+static_assert(sizeof(IntrusiveArc<CountedObject, alloc::IntrusivePool>) == sizeof(void*));
+
+TEST(wesos_smartptr, IntrusiveArc) {
+  using Shared = IntrusiveArc<CountedObject, alloc::IntrusivePool>;
+
+  /* A single pool object per handle group: there is no separate count block */
+  std::vector<u8> storage(Shared::min_alloc_size());
+  auto pool = alloc::IntrusivePool(Shared::min_alloc_size(), Shared::min_alloc_alignment(),
+                                   View<u8>(storage.data(), storage.size()));
+
+  usize constructed = 0;
+  usize moved = 0;
+  usize copied = 0;
+  usize destructed = 0;
+
+  {
+    auto arc = Shared::create(pool, constructed, moved, copied, destructed);
+    ASSERT_TRUE(arc);
+    ASSERT_EQ(arc->ref_count(), 1);
+    ASSERT_FALSE(Shared::create(pool, constructed, moved, copied, destructed));
+
+    auto clone = arc.value();
+    ASSERT_EQ(clone.ref_count(), 2);
+
+    auto from_this = Shared::from_this(clone.get());
+    ASSERT_EQ(from_this.ref_count(), 3);
+    ASSERT_EQ(from_this.unwrap(), arc->unwrap());
+
+    clone = from_this;
+    ASSERT_EQ(clone.ref_count(), 3);
+
+    auto moved_arc = std::move(clone);
+    ASSERT_TRUE(clone.is_null());
+    ASSERT_EQ(moved_arc.ref_count(), 3);
+  }
+
+  ASSERT_EQ(constructed, 1);
+  ASSERT_EQ(copied, 0);
+  ASSERT_EQ(destructed, 1);
+
+  ASSERT_TRUE(Shared::create(pool, constructed, moved, copied, destructed));
+}
+
+TEST(wesos_smartptr, IntrusiveArc_Threads) {
+  using Shared = IntrusiveArc<ThreadedObject, alloc::AtomicIntrusivePool>;
+
+  constexpr usize thread_count = 4;
+  constexpr usize clones_per_thread = 10000;
+
+  std::vector<u8> storage(Shared::min_alloc_size());
+  auto pool = alloc::AtomicIntrusivePool(Shared::min_alloc_size(), Shared::min_alloc_alignment(),
+                                         View<u8>(storage.data(), storage.size()));
+
+  {
+    auto arc = Shared::create(pool);
+    ASSERT_TRUE(arc);
+
+    std::vector<std::thread> threads;
+    for (usize i = 0; i < thread_count; i++) {
+      threads.emplace_back([handle = arc.value()]() {
+        for (usize j = 0; j < clones_per_thread; j++) {
+          auto clone = handle;
+          (void)clone;
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    ASSERT_EQ(arc->ref_count(), 1);
+  }
+
+  ASSERT_TRUE(pool.allocate_bytes(Shared::min_alloc_size(), Shared::min_alloc_alignment()).isset());
+}
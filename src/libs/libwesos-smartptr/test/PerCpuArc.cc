@@ -0,0 +1,105 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+#include <wesos-alloc/AtomicIntrusivePool.hh>
+#include <wesos-alloc/IntrusivePool.hh>
+#include <wesos-smartptr/PerCpuArc.hh>
+
+#include "Helper.hh"
+
+using namespace wesos;
+using namespace wesos::smartptr;
+
+TEST(wesos_smartptr, PerCpuArc) {
+  using Shared = PerCpuArc<SemanticCounter, alloc::IntrusivePool>;
+
+  std::vector<u8> storage(Shared::min_alloc_size() + Shared::min_alloc_alignment().unwrap());
+  auto pool = alloc::IntrusivePool(Shared::min_alloc_size(), Shared::min_alloc_alignment(),
+                                   View<u8>(storage.data(), storage.size()));
+
+  usize constructed = 0;
+  usize moved = 0;
+  usize copied = 0;
+  usize destructed = 0;
+
+  {
+    auto owner = Shared::create(pool, constructed, moved, copied, destructed);
+    ASSERT_TRUE(owner);
+    ASSERT_FALSE(owner->ref_count());
+
+    std::vector<Shared> clones(4, owner.value());
+    clones.pop_back();
+
+    owner->kill();
+    ASSERT_TRUE(owner->is_null());
+    ASSERT_EQ(destructed, 0);
+
+    ASSERT_EQ(clones.front().ref_count().value(), 3);
+
+    auto late_clone = clones.front();
+    ASSERT_EQ(late_clone.ref_count().value(), 4);
+
+    clones.clear();
+    ASSERT_EQ(destructed, 0);
+    ASSERT_EQ(late_clone.ref_count().value(), 1);
+  }
+
+  ASSERT_EQ(constructed, 1);
+  ASSERT_EQ(copied, 0);
+  ASSERT_EQ(destructed, 1);
+
+  /* The whole block went back to the pool */
+  ASSERT_TRUE(Shared::create(pool, constructed, moved, copied, destructed));
+}
+
+TEST(wesos_smartptr, PerCpuArc_KillWhileCloning) {
+  using Shared = PerCpuArc<SemanticCounter, alloc::AtomicIntrusivePool>;
+
+  constexpr usize thread_count = 4;
+  constexpr usize clones_per_thread = 20000;
+
+  std::vector<u8> storage(Shared::min_alloc_size() + Shared::min_alloc_alignment().unwrap());
+  auto pool = alloc::AtomicIntrusivePool(Shared::min_alloc_size(), Shared::min_alloc_alignment(),
+                                         View<u8>(storage.data(), storage.size()));
+
+  usize constructed = 0;
+  usize moved = 0;
+  usize copied = 0;
+  usize destructed = 0;
+
+  {
+    auto owner = Shared::create(pool, constructed, moved, copied, destructed);
+    ASSERT_TRUE(owner);
+
+    std::vector<std::thread> threads;
+    for (usize i = 0; i < thread_count; i++) {
+      threads.emplace_back([handle = owner.value()]() {
+        for (usize j = 0; j < clones_per_thread; j++) {
+          auto clone = handle;
+          if (j % 64 == 0) {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+
+    /* Collapse the counters while the other threads are still cloning */
+    std::this_thread::yield();
+    owner->kill();
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  ASSERT_EQ(constructed, 1);
+  ASSERT_EQ(destructed, 1);
+}
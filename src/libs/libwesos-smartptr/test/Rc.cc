@@ -7,6 +7,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+#include <wesos-alloc/IntrusivePool.hh>
 #include <wesos-smartptr/Rc.hh>
 
 #include "Helper.hh"
@@ -15,6 +17,79 @@ using namespace wesos;
 using namespace wesos::smartptr;
 
 TEST(wesos_smartptr, Rc) {
-  // TODO: Implement the test for Rc
-  FAIL() << "Not implemented yet";
+  using Shared = Rc<SemanticCounter, alloc::IntrusivePool>;
+
+  /* Room for one object and its state block */
+  std::vector<u8> storage(Shared::min_alloc_size() * 2);
+  auto pool = alloc::IntrusivePool(Shared::min_alloc_size(), Shared::min_alloc_alignment(),
+                                   View<u8>(storage.data(), storage.size()));
+
+  usize constructed = 0;
+  usize moved = 0;
+  usize copied = 0;
+  usize destructed = 0;
+
+  {
+    auto rc = Shared::create(pool, constructed, moved, copied, destructed);
+    ASSERT_TRUE(rc);
+    ASSERT_EQ(rc->ref_count(), 1);
+
+    auto clone = rc.value();
+    ASSERT_EQ(clone.ref_count(), 2);
+    ASSERT_EQ(clone.unwrap(), rc->unwrap());
+
+    clone = rc.value();
+    ASSERT_EQ(clone.ref_count(), 2);
+
+    auto moved_rc = std::move(clone);
+    ASSERT_EQ(moved_rc.ref_count(), 2);
+    ASSERT_TRUE(clone.is_null());
+  }
+
+  ASSERT_EQ(constructed, 1);
+  ASSERT_EQ(moved, 0);
+  ASSERT_EQ(copied, 0);
+  ASSERT_EQ(destructed, 1);
+}
+
+TEST(wesos_smartptr, Rc_Weak) {
+  using Shared = Rc<SemanticCounter, alloc::IntrusivePool>;
+
+  std::vector<u8> storage(Shared::min_alloc_size() * 2);
+  auto pool = alloc::IntrusivePool(Shared::min_alloc_size(), Shared::min_alloc_alignment(),
+                                   View<u8>(storage.data(), storage.size()));
+
+  usize constructed = 0;
+  usize moved = 0;
+  usize copied = 0;
+  usize destructed = 0;
+
+  auto weak = [&] {
+    auto rc = Shared::create(pool, constructed, moved, copied, destructed);
+    EXPECT_TRUE(rc);
+
+    auto weak = rc->downgrade();
+    EXPECT_FALSE(weak.expired());
+
+    auto upgraded = weak.upgrade();
+    EXPECT_TRUE(upgraded);
+    EXPECT_EQ(rc->ref_count(), 2);
+
+    return weak;
+  }();
+
+  ASSERT_EQ(destructed, 1);
+  ASSERT_TRUE(weak.expired());
+  ASSERT_FALSE(weak.upgrade());
+
+  /* The object's memory is back in the pool even though the state block is still held */
+  auto object = pool.allocate_bytes(Shared::min_alloc_size(), Shared::min_alloc_alignment());
+  ASSERT_TRUE(object.isset());
+  ASSERT_FALSE(pool.allocate_bytes(Shared::min_alloc_size(), Shared::min_alloc_alignment()).isset());
+
+  {
+    auto last = std::move(weak);
+  }
+
+  ASSERT_TRUE(pool.allocate_bytes(Shared::min_alloc_size(), Shared::min_alloc_alignment()).isset());
 }
@@ -0,0 +1,65 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <wesos-alloc/IntrusivePool.hh>
+#include <wesos-smartptr/StaticBox.hh>
+
+#include "Helper.hh"
+
+using namespace wesos;
+using namespace wesos::smartptr;
+
+namespace {
+  struct PoolProvider {
+    [[nodiscard]] static auto resource() -> alloc::IntrusivePool& {
+      alignas(SemanticCounter) static Array<u8, sizeof(SemanticCounter) * 2> storage;
+      static auto pool = alloc::IntrusivePool(sizeof(SemanticCounter), alignof(SemanticCounter), storage.as_view());
+      return pool;
+    }
+  };
+}  // namespace
+
+static_assert(sizeof(StaticBox<SemanticCounter, PoolProvider>) == sizeof(void*));
+
+TEST(wesos_smartptr, StaticBox) {
+  using Boxed = StaticBox<SemanticCounter, PoolProvider>;
+
+  usize constructed = 0;
+  usize moved = 0;
+  usize copied = 0;
+  usize destructed = 0;
+
+  {
+    auto box = Boxed::create(constructed, moved, copied, destructed);
+    ASSERT_TRUE(box);
+    ASSERT_EQ(&Boxed::memory_resource(), &PoolProvider::resource());
+
+    auto box2 = Boxed::create(constructed, moved, copied, destructed);
+    ASSERT_TRUE(box2);
+    ASSERT_FALSE(Boxed::create(constructed, moved, copied, destructed));
+
+    /* Move assignment destroys the object that was there before */
+    box.value() = std::move(box2.value());
+    ASSERT_TRUE(box2->is_null());
+    ASSERT_EQ(destructed, 1);
+
+    auto box3 = std::move(box.value());
+    ASSERT_TRUE(box->is_null());
+    ASSERT_TRUE(box3.isset());
+  }
+
+  ASSERT_EQ(constructed, 2);
+  ASSERT_EQ(moved, 0);
+  ASSERT_EQ(copied, 0);
+  ASSERT_EQ(destructed, 2);
+
+  auto again = Boxed::create(constructed, moved, copied, destructed);
+  auto again2 = Boxed::create(constructed, moved, copied, destructed);
+  ASSERT_TRUE(again && again2);
+}
@@ -0,0 +1,43 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <wesos-sync/Epoch.hh>
+
+using namespace wesos;
+using namespace wesos::sync;
+
+static constexpr int EPOCH_MAX_THREADS = 16;
+
+static void BM_Epoch_ReadSide(benchmark::State& state) {
+  static EpochDomain domain;
+  static u64 shared_value = 0;
+
+  for (auto x : state) {
+    domain.read_critical_section([] { benchmark::DoNotOptimize(shared_value); });
+  }
+
+  state.SetItemsProcessed(isize(state.iterations()));
+}
+
+/* Includes the allocator round trip, since that is what a retired node costs in practice */
+static void BM_Epoch_RetireReclaim(benchmark::State& state) {
+  struct Node final : EpochNode {};
+
+  static EpochDomain domain;
+
+  for (auto x : state) {
+    domain.retire(new Node, [](EpochNode* node) { delete static_cast<Node*>(node); });
+  }
+
+  domain.synchronize();
+  state.SetItemsProcessed(isize(state.iterations()));
+}
+
+BENCHMARK(BM_Epoch_ReadSide)->ThreadRange(1, EPOCH_MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_Epoch_RetireReclaim);
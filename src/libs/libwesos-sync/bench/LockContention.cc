@@ -0,0 +1,39 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <wesos-sync/McsLock.hh>
+#include <wesos-sync/SpinLock.hh>
+#include <wesos-sync/TicketLock.hh>
+
+using namespace wesos;
+using namespace wesos::sync;
+
+static constexpr int CONTENTION_MAX_THREADS = 16;
+
+namespace {
+  template <class Lock>
+  void lock_contention(benchmark::State& state) {
+    static Lock lock;
+    static u64 shared_counter = 0;
+
+    for (auto x : state) {
+      lock.critical_section([] { benchmark::DoNotOptimize(++shared_counter); });
+    }
+
+    state.SetItemsProcessed(isize(state.iterations()));
+  }
+}  // namespace
+
+static void BM_SpinLock_Contention(benchmark::State& state) { lock_contention<SpinLock>(state); }
+static void BM_TicketLock_Contention(benchmark::State& state) { lock_contention<TicketLock>(state); }
+static void BM_McsLock_Contention(benchmark::State& state) { lock_contention<McsLock>(state); }
+
+BENCHMARK(BM_SpinLock_Contention)->ThreadRange(1, CONTENTION_MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_TicketLock_Contention)->ThreadRange(1, CONTENTION_MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_McsLock_Contention)->ThreadRange(1, CONTENTION_MAX_THREADS)->UseRealTime();
@@ -0,0 +1,41 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <wesos-sync/RwSpinLock.hh>
+#include <wesos-sync/SpinLock.hh>
+
+using namespace wesos;
+using namespace wesos::sync;
+
+static constexpr int READERS_MAX_THREADS = 16;
+
+static void BM_SpinLock_ReadMostly(benchmark::State& state) {
+  static SpinLock lock;
+  static u64 shared_value = 0;
+
+  for (auto x : state) {
+    lock.critical_section([] { benchmark::DoNotOptimize(shared_value); });
+  }
+
+  state.SetItemsProcessed(isize(state.iterations()));
+}
+
+static void BM_RwSpinLock_ReadMostly(benchmark::State& state) {
+  static RwSpinLock lock;
+  static u64 shared_value = 0;
+
+  for (auto x : state) {
+    lock.read_critical_section([] { benchmark::DoNotOptimize(shared_value); });
+  }
+
+  state.SetItemsProcessed(isize(state.iterations()));
+}
+
+BENCHMARK(BM_SpinLock_ReadMostly)->ThreadRange(1, READERS_MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_RwSpinLock_ReadMostly)->ThreadRange(1, READERS_MAX_THREADS)->UseRealTime();
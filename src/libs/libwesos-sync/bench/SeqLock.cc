@@ -0,0 +1,48 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <wesos-sync/SeqLock.hh>
+#include <wesos-sync/SpinLock.hh>
+
+using namespace wesos;
+using namespace wesos::sync;
+
+static constexpr int READERS_MAX_THREADS = 16;
+
+namespace {
+  struct Snapshot {
+    u64 m_ticks;
+    u64 m_nanoseconds;
+    u64 m_offset;
+  };
+}  // namespace
+
+static void BM_SpinLock_Snapshot(benchmark::State& state) {
+  static SpinLock lock;
+  static Snapshot shared = {};
+
+  for (auto x : state) {
+    benchmark::DoNotOptimize(lock.critical_section([] { return shared; }));
+  }
+
+  state.SetItemsProcessed(isize(state.iterations()));
+}
+
+static void BM_SeqLock_Snapshot(benchmark::State& state) {
+  static SeqLock<Snapshot> lock;
+
+  for (auto x : state) {
+    benchmark::DoNotOptimize(lock.read());
+  }
+
+  state.SetItemsProcessed(isize(state.iterations()));
+}
+
+BENCHMARK(BM_SpinLock_Snapshot)->ThreadRange(1, READERS_MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_SeqLock_Snapshot)->ThreadRange(1, READERS_MAX_THREADS)->UseRealTime();
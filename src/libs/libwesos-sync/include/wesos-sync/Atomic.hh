@@ -72,6 +72,13 @@ namespace wesos::sync {
       return detail::atomic::fetch_add(&m_value, val, order);
     }
 
+    /**
+     * @brief Adds `val` with a single unlocked instruction where the target has one.
+     * @note That cannot be split by an interrupt or a context switch, but it is not
+     * atomic against other CPUs. Only use it on data that one CPU writes at a time.
+     */
+    void add_local(Atom val) { detail::atomic::add_local(&m_value, val); }
+
     auto fetch_sub(Atom val, MemoryOrder order = memory_order_seq_cst) -> Atom {
       return detail::atomic::fetch_sub(&m_value, val, order);
     }
@@ -97,4 +104,6 @@ namespace wesos::sync {
     auto operator--() -> Atom { return fetch_sub(1) - 1; }
     auto operator--(int) -> Atom { return fetch_sub(1); }
   };
+
+  static inline void atomic_thread_fence(MemoryOrder order) { detail::atomic::thread_fence(order); }
 }  // namespace wesos::sync
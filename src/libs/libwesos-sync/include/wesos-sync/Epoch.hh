@@ -0,0 +1,164 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-cpu/PerCpu.hh>
+#include <wesos-sync/Atomic.hh>
+#include <wesos-types/Template.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::sync {
+  class EpochDomain;
+
+  /**
+   * @brief Intrusive header for objects handed to `EpochDomain::retire`.
+   *
+   * Retiring never allocates: the limbo lists are threaded through these headers.
+   */
+  class EpochNode {
+    friend class EpochDomain;
+
+    EpochNode* m_next = nullptr;
+    void (*m_reclaim)(EpochNode*) = nullptr;
+    void* m_context = nullptr;
+    u64 m_epoch = 0;
+
+  public:
+    constexpr EpochNode() = default;
+    constexpr EpochNode(const EpochNode&) = delete;
+    constexpr EpochNode(EpochNode&&) = delete;
+    constexpr auto operator=(const EpochNode&) -> EpochNode& = delete;
+    constexpr auto operator=(EpochNode&&) -> EpochNode& = delete;
+    constexpr ~EpochNode() = default;
+
+    [[nodiscard]] constexpr auto context() const -> void* { return m_context; }
+  };
+
+  /**
+   * @brief Epoch-based reclamation, so lock-free readers never touch freed memory.
+   *
+   * Readers bracket their accesses with `enter`/`exit`. That costs one atomic on
+   * the caller's CPU slot and never writes a shared line. A writer unlinks a node
+   * and then `retire`s it onto its CPU's limbo list. A node is reclaimed once the
+   * global epoch has advanced twice past its retirement, because by then every
+   * reader that could still see it has exited. The epoch only advances when every
+   * active slot has observed the current one.
+   *
+   * `enter` returns the slot it used; pass it back to `exit`, since the caller may
+   * have migrated in between. Readers that share a slot keep the epoch of the first
+   * one in, which is conservative: a slot that never drains holds up reclamation,
+   * but never makes it unsafe.
+   *
+   * Retiring collects the local limbo list every `COLLECT_THRESHOLD` nodes.
+   * `collect` and `synchronize` reclaim on demand.
+   *
+   * @note Never call `synchronize` or destroy the domain from inside a read-side
+   * critical section.
+   */
+  class EpochDomain final {
+    static constexpr u64 READER_BITS = 16;
+    static constexpr u64 READER_MASK = (u64(1) << READER_BITS) - 1;
+    static constexpr usize COLLECT_THRESHOLD = 64;
+
+    struct Slot {
+      /* (epoch << READER_BITS) | readers; no readers means quiescent */
+      Atomic<u64> m_state = 0;
+      Atomic<EpochNode*> m_limbo = nullptr;
+      Atomic<usize> m_pending = 0;
+    };
+
+    Atomic<u64> m_epoch;
+    cpu::PerCpu<Slot> m_slots;
+
+    auto push_limbo(Slot& slot, EpochNode* head, EpochNode* tail) -> void;
+    auto collect_slot(Slot& slot, bool everything) -> usize;
+
+  public:
+    class ReadLease final {
+      friend class EpochDomain;
+      EpochDomain& m_parent;
+      usize m_slot;
+
+      ReadLease(EpochDomain& parent, usize slot) : m_parent(parent), m_slot(slot) {}
+
+    public:
+      ReadLease(const ReadLease&) = delete;
+      ReadLease(ReadLease&&) = delete;
+
+      ~ReadLease() { m_parent.exit(m_slot); }
+    };
+
+    constexpr EpochDomain() : m_epoch(0) {}
+    constexpr EpochDomain(const EpochDomain&) = delete;
+    constexpr EpochDomain(EpochDomain&&) = delete;
+    constexpr auto operator=(const EpochDomain&) -> EpochDomain& = delete;
+    constexpr auto operator=(EpochDomain&&) -> EpochDomain& = delete;
+
+    /**
+     * @brief Reclaims every node still in limbo.
+     * @note No reader may be inside a critical section.
+     */
+    ~EpochDomain();
+
+    [[nodiscard]] auto enter() -> usize;
+    auto exit(usize slot) -> void;
+
+    [[nodiscard]] auto read_lease() -> ReadLease { return {*this, enter()}; }
+
+    auto read_critical_section(const auto& code) {
+      const auto slot = enter();
+      auto _ = defer([&] { exit(slot); });
+      return code();
+    }
+
+    /**
+     * @brief Defers `reclaim(node)` until no reader can still hold `node`.
+     * @note `node` must already be unreachable for new readers.
+     */
+    auto retire(EpochNode* node, void (*reclaim)(EpochNode* node), void* context = nullptr) -> void;
+
+    /**
+     * @brief Destroys `object` and returns its memory to `mm` once no reader can hold it.
+     *
+     * `Resource` is anything with `deallocate_bytes(ptr, size, align)`, such as
+     * `mem::MemoryResourceProtocol`. It must outlive the domain's limbo lists.
+     */
+    template <class Object, class Resource>
+      requires(types::is_base_of_v<EpochNode, Object>)
+    auto retire(Resource& mm, Object* object) -> void {
+      retire(
+          object,
+          [](EpochNode* node) {
+            auto* object = static_cast<Object*>(node);
+            auto& mm = *static_cast<Resource*>(node->context());
+
+            object->~Object();
+            mm.deallocate_bytes(object, sizeof(Object), alignof(Object));
+          },
+          &mm);
+    }
+
+    /**
+     * @brief Advances the global epoch if every active reader has caught up with it.
+     */
+    auto try_advance() -> bool;
+
+    /**
+     * @brief Tries to advance, then reclaims every eligible node on all CPUs.
+     * @return The number of nodes reclaimed.
+     */
+    auto collect() -> usize;
+
+    /**
+     * @brief Waits out two epochs, then reclaims every node retired before the call.
+     */
+    auto synchronize() -> void;
+
+    [[nodiscard]] auto epoch() const -> u64 { return m_epoch.load(memory_order_relaxed); }
+  };
+}  // namespace wesos::sync
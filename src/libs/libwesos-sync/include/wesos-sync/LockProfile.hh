@@ -0,0 +1,75 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-builtin/SourceLocation.hh>
+#include <wesos-sync/Atomic.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::sync {
+  struct LockProfile;
+
+  /**
+   * @brief Contention counters shared by every lock constructed at one source location.
+   *
+   * Locks only record into these when the build defines `WESOS_LOCK_PROFILING`
+   * (the `WESOS_LOCK_PROFILING` CMake option). Sites live in a fixed table, so a
+   * lock can be destroyed at any time without unregistering.
+   */
+  class LockSite final {
+    friend auto lock_profile_site(SourceLocation site) -> LockSite&;
+    friend auto lock_profile_for_each(void* context, void (*callback)(void* context, const LockProfile& profile))
+        -> void;
+    friend auto lock_profile_reset() -> void;
+
+    SourceLocation m_site;
+    Atomic<u8> m_state;
+    Atomic<u64> m_acquisitions;
+    Atomic<u64> m_contended;
+    Atomic<u64> m_spin_cycles;
+    Atomic<u64> m_max_hold_cycles;
+
+  public:
+    constexpr LockSite() : m_state(0), m_acquisitions(0), m_contended(0), m_spin_cycles(0), m_max_hold_cycles(0) {}
+
+    [[nodiscard]] auto site() const -> const SourceLocation& { return m_site; }
+
+    auto record_acquire(bool contended, u64 spin_cycles) -> void;
+    auto record_release(u64 hold_cycles) -> void;
+  };
+
+  /**
+   * @brief A point-in-time copy of one site's counters.
+   */
+  struct LockProfile {
+    SourceLocation m_site;
+    u64 m_acquisitions;
+    u64 m_contended;
+    u64 m_spin_cycles;
+    u64 m_max_hold_cycles;
+  };
+
+  /** @brief Number of distinct sites tracked; later sites share one overflow entry. */
+  static constexpr usize LOCK_PROFILE_SITES = 256;
+
+  /**
+   * @brief Finds or claims the entry for `site`.
+   * @note Thread-safe. Sites are matched by file name pointer and line number.
+   */
+  [[nodiscard]] auto lock_profile_site(SourceLocation site) -> LockSite&;
+
+  /**
+   * @brief Calls `callback` once for every site that has recorded an acquisition.
+   */
+  auto lock_profile_for_each(void* context, void (*callback)(void* context, const LockProfile& profile)) -> void;
+
+  /**
+   * @brief Zeroes the counters of every site; the sites themselves stay registered.
+   */
+  auto lock_profile_reset() -> void;
+}  // namespace wesos::sync
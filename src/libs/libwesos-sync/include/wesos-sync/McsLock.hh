@@ -0,0 +1,48 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-sync/Atomic.hh>
+#include <wesos-sync/LockProtocol.hh>
+
+namespace wesos::sync {
+  /**
+   * @brief FIFO queue lock where each waiter spins on its own cache line.
+   *
+   * This is the K42 variant of the MCS lock. Waiters queue up on nodes on their own
+   * stack. The holder's node is embedded in the lock, so `lock` and `unlock` need no
+   * node argument. Each handoff touches only the next waiter's line, so the cost of
+   * a contended handoff does not grow with the number of waiters.
+   *
+   * @note The lock refers to its own address while held, so it cannot be moved.
+   */
+  class McsLock final {
+    struct Node {
+      Atomic<Node*> m_tail;
+      Atomic<Node*> m_next;
+    };
+
+    Node m_queue;
+
+    [[nodiscard]] static auto waiting() -> Node* { return bit_cast<Node*>(uptr(1)); }
+
+  public:
+    constexpr McsLock() : m_queue{nullptr, nullptr} {}
+    constexpr McsLock(const McsLock&) = delete;
+    constexpr McsLock(McsLock&&) = delete;
+    constexpr auto operator=(const McsLock&) -> McsLock& = delete;
+    constexpr auto operator=(McsLock&&) -> McsLock& = delete;
+    constexpr ~McsLock() = default;
+
+    auto lock() -> void;
+    auto unlock() -> void;
+    auto try_lock() -> bool;
+
+    W_LOCK_PROTOCOL_IMPLEMENT(McsLock);
+  };
+}  // namespace wesos::sync
@@ -0,0 +1,78 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-cpu/PerCpu.hh>
+#include <wesos-sync/Atomic.hh>
+#include <wesos-sync/LockProtocol.hh>
+
+namespace wesos::sync {
+  /**
+   * @brief Reader-writer spin lock for read-mostly data, with writer preference.
+   *
+   * Each reader announces itself in its CPU's slot and then checks the writer flag.
+   * The only shared line a reader touches is that flag, and it only reads it, so
+   * readers on different CPUs do not contend. A writer raises the flag, which holds
+   * back new readers, and then waits for every slot to drain.
+   *
+   * `read_lock` returns the slot it used; pass it back to `read_unlock`, since the
+   * caller may have migrated in between. The write side is the usual
+   * `lock`/`unlock`/`try_lock` surface, with `W_LOCK_PROTOCOL_IMPLEMENT` helpers.
+   *
+   * @note Every lock carries `cpu::MAX_CPUS` cache lines of reader slots, so keep
+   * these for a few hot, shared structures.
+   */
+  class RwSpinLock final {
+    Atomic<bool> m_writer;
+    cpu::PerCpu<Atomic<usize>> m_readers;
+
+    [[nodiscard]] auto readers_drained() const -> bool;
+
+  public:
+    class ReadLease final {
+      friend class RwSpinLock;
+      RwSpinLock& m_parent;
+      usize m_slot;
+
+      ReadLease(RwSpinLock& parent, usize slot) : m_parent(parent), m_slot(slot) {}
+
+    public:
+      ReadLease(const ReadLease&) = delete;
+      ReadLease(ReadLease&&) = delete;
+
+      ~ReadLease() { m_parent.read_unlock(m_slot); }
+    };
+
+    constexpr RwSpinLock() : m_writer(false) {}
+    constexpr RwSpinLock(const RwSpinLock&) = delete;
+    constexpr RwSpinLock(RwSpinLock&&) = delete;
+    constexpr auto operator=(const RwSpinLock&) -> RwSpinLock& = delete;
+    constexpr auto operator=(RwSpinLock&&) -> RwSpinLock& = delete;
+    constexpr ~RwSpinLock() = default;
+
+    [[nodiscard]] auto read_lock() -> usize;
+    auto read_unlock(usize slot) -> void;
+    [[nodiscard]] auto try_read_lock() -> Nullable<usize>;
+
+    auto lock() -> void;
+    auto unlock() -> void;
+    auto try_lock() -> bool;
+
+    [[nodiscard]] auto read_lease() -> ReadLease { return {*this, read_lock()}; }
+
+    auto read_critical_section(const auto& code) {
+      const auto slot = read_lock();
+      auto _ = defer([&] { read_unlock(slot); });
+      return code();
+    }
+
+    auto write_critical_section(const auto& code) { return critical_section(code); }
+
+    W_LOCK_PROTOCOL_IMPLEMENT(RwSpinLock);
+  };
+}  // namespace wesos::sync
@@ -0,0 +1,132 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-cpu/Timing.hh>
+#include <wesos-sync/Atomic.hh>
+#include <wesos-types/Types.hh>
+
+namespace wesos::sync {
+  /**
+   * @brief Small value that many CPUs read and few write, where reads never write shared memory.
+   *
+   * A writer makes the sequence odd, stores the value, and makes it even again.
+   * A reader copies the value between two loads of the sequence, and retries if
+   * they differ or are odd. Readers therefore only ever load, so the value's cache
+   * lines stay shared between all readers.
+   *
+   * The value is kept as relaxed atomic words, so a reader that races a writer sees
+   * a stale or torn copy (which it throws away) rather than a data race. Writers
+   * exclude each other on the sequence itself.
+   *
+   * @note Keep `T` small; a reader retries the whole copy on every concurrent write.
+   */
+  template <class T>
+    requires(__is_trivially_copyable(T))
+  class SeqLock final {
+    static constexpr usize WORDS = (sizeof(T) + sizeof(usize) - 1) / sizeof(usize);
+
+    Atomic<usize> m_sequence;
+    Atomic<usize> m_words[WORDS];  // NOLINT(modernize-avoid-c-arrays)
+
+    auto load_words(T& value) const -> void {
+      usize words[WORDS];  // NOLINT(modernize-avoid-c-arrays)
+      for (usize i = 0; i < WORDS; i++) {
+        words[i] = m_words[i].load(memory_order_relaxed);
+      }
+
+      __builtin_memcpy(&value, words, sizeof(T));
+    }
+
+    auto store_words(const T& value) -> void {
+      usize words[WORDS] = {};  // NOLINT(modernize-avoid-c-arrays)
+      __builtin_memcpy(words, &value, sizeof(T));
+
+      for (usize i = 0; i < WORDS; i++) {
+        m_words[i].store(words[i], memory_order_relaxed);
+      }
+    }
+
+    [[nodiscard]] auto begin_write() -> usize {
+      while (true) {
+        auto sequence = m_sequence.load(memory_order_relaxed);
+
+        if ((sequence & 1) == 0 &&
+            m_sequence.compare_exchange_weak(sequence, sequence + 1, memory_order_acquire, memory_order_relaxed))
+            [[likely]] {
+          /* Keep the value's stores after the odd sequence */
+          atomic_thread_fence(memory_order_release);
+          return sequence + 2;
+        }
+
+        cpu::ephemeral_pause();
+      }
+    }
+
+    auto end_write(usize sequence) -> void { m_sequence.store(sequence, memory_order_release); }
+
+  public:
+    SeqLock(const T& value = T()) : m_sequence(0) { store_words(value); }
+    SeqLock(const SeqLock&) = delete;
+    SeqLock(SeqLock&&) = delete;
+    auto operator=(const SeqLock&) -> SeqLock& = delete;
+    auto operator=(SeqLock&&) -> SeqLock& = delete;
+    ~SeqLock() = default;
+
+    /**
+     * @brief Takes one snapshot, or returns null if a writer got in the way.
+     */
+    [[nodiscard]] auto try_read() const -> Nullable<T> {
+      const auto before = m_sequence.load(memory_order_acquire);
+      if ((before & 1) != 0) [[unlikely]] {
+        return null;
+      }
+
+      T value;
+      load_words(value);
+
+      /* Keep the value's loads before the second sequence load */
+      atomic_thread_fence(memory_order_acquire);
+      if (m_sequence.load(memory_order_relaxed) != before) [[unlikely]] {
+        return null;
+      }
+
+      return value;
+    }
+
+    [[nodiscard]] auto read() const -> T {
+      while (true) {
+        if (auto value = try_read()) [[likely]] {
+          return value.value();
+        }
+
+        cpu::ephemeral_pause();
+      }
+    }
+
+    auto write(const T& value) -> void {
+      const auto sequence = begin_write();
+      store_words(value);
+      end_write(sequence);
+    }
+
+    /**
+     * @brief Read-modify-write with other writers excluded.
+     */
+    auto update(const auto& code) -> void {
+      const auto sequence = begin_write();
+
+      T value;
+      load_words(value);
+      code(value);
+      store_words(value);
+
+      end_write(sequence);
+    }
+  };
+}  // namespace wesos::sync
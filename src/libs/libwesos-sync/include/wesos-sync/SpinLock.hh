@@ -7,15 +7,46 @@
 
 #pragma once
 
+#include <wesos-builtin/SourceLocation.hh>
 #include <wesos-sync/Atomic.hh>
+#include <wesos-sync/LockProfile.hh>
 #include <wesos-sync/LockProtocol.hh>
 
 namespace wesos::sync {
+  /**
+   * @brief Test-and-test-and-set lock with bounded exponential backoff.
+   *
+   * When built with `WESOS_LOCK_PROFILING`, every lock records acquisitions,
+   * contended acquisitions, spin cycles and the longest hold into the `LockSite`
+   * of the place it was constructed. Pass `site` explicitly for locks that are
+   * built inside a factory, otherwise they all share the factory's site.
+   */
   class SpinLock final {
+    /* Pauses between polls of a held lock, doubling up to the cap */
+    static constexpr u32 BACKOFF_MIN = 1;
+    static constexpr u32 BACKOFF_MAX = 64;
+
     Atomic<bool> m_locked;
+#if WESOS_LOCK_PROFILING
+    SourceLocation m_site;
+    LockSite* m_stats = nullptr;
+    u64 m_acquired_at = 0;
+
+    auto profile_acquire(bool contended, u64 spin_cycles) -> void;
+#endif
+
+    auto lock_contended() -> void;
 
   public:
-    constexpr SpinLock() : m_locked(false) {}
+    constexpr SpinLock([[maybe_unused]] SourceLocation site = SourceLocation::current())
+        : m_locked(false)
+#if WESOS_LOCK_PROFILING
+          ,
+          m_site(site)
+#endif
+    {
+    }
+
     constexpr SpinLock(const SpinLock&) = delete;
     constexpr SpinLock(SpinLock&&) = default;
     constexpr auto operator=(const SpinLock&) -> SpinLock& = delete;
@@ -0,0 +1,38 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#pragma once
+
+#include <wesos-sync/Atomic.hh>
+#include <wesos-sync/LockProtocol.hh>
+
+namespace wesos::sync {
+  /**
+   * @brief FIFO spin lock: waiters take a ticket and are served in order.
+   *
+   * Unlike `SpinLock`, no waiter can starve. All waiters still poll the same
+   * counter, so use `McsLock` when many CPUs contend for a long time.
+   */
+  class TicketLock final {
+    Atomic<u32> m_next_ticket;
+    Atomic<u32> m_now_serving;
+
+  public:
+    constexpr TicketLock() : m_next_ticket(0), m_now_serving(0) {}
+    constexpr TicketLock(const TicketLock&) = delete;
+    constexpr TicketLock(TicketLock&&) = default;
+    constexpr auto operator=(const TicketLock&) -> TicketLock& = delete;
+    constexpr auto operator=(TicketLock&&) -> TicketLock& = default;
+    constexpr ~TicketLock() = default;
+
+    auto lock() -> void;
+    auto unlock() -> void;
+    auto try_lock() -> bool;
+
+    W_LOCK_PROTOCOL_IMPLEMENT(TicketLock);
+  };
+}  // namespace wesos::sync
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <wesos-cpu/Target.hh>
 #include <wesos-sync/MemoryOrder.hh>
 
 namespace wesos::sync::detail::atomic {
@@ -54,6 +55,19 @@ namespace wesos::sync::detail::atomic {
     return __atomic_fetch_add(ptr, val, order);
   }
 
+  template <class Atom>
+  void add_local(Atom* ptr, Atom val) {
+#if ARCH_X86_64 || ARCH_X86_32
+    if constexpr (sizeof(Atom) <= sizeof(void*)) {
+      asm volatile("add %1, %0" : "+m"(*ptr) : "r"(val));
+    } else {
+      __atomic_fetch_add(ptr, val, __ATOMIC_RELAXED);
+    }
+#else
+    __atomic_fetch_add(ptr, val, __ATOMIC_RELAXED);
+#endif
+  }
+
   template <class Atom>
   auto fetch_sub(Atom* ptr, Atom val, MemoryOrder order) -> Atom {
     return __atomic_fetch_sub(ptr, val, order);
@@ -78,4 +92,6 @@ namespace wesos::sync::detail::atomic {
   auto fetch_nand(Atom* ptr, Atom val, MemoryOrder order) -> Atom {
     return __atomic_fetch_nand(ptr, val, order);
   }
+
+  static inline void thread_fence(MemoryOrder order) { __atomic_thread_fence(order); }
 }  // namespace wesos::sync::detail::atomic
@@ -0,0 +1,152 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-builtin/Export.hh>
+#include <wesos-cpu/Timing.hh>
+#include <wesos-sync/Epoch.hh>
+
+using namespace wesos;
+using namespace wesos::sync;
+
+/*
+ * A reader publishes its slot with a sequentially consistent RMW before it loads
+ * any shared pointer. An advancer issues a sequentially consistent fence before it
+ * scans the slots. So either the advancer sees the reader and waits for it, or the
+ * reader runs after the advance and can no longer reach what was retired before it.
+ *
+ * Slots only compare the low bits of the epoch, which wrap after 2^48 advances.
+ */
+
+SYM_EXPORT EpochDomain::~EpochDomain() {
+  m_slots.for_each([&](Slot& slot) {
+    assert_always((slot.m_state.load(memory_order_relaxed) & READER_MASK) == 0);
+    collect_slot(slot, true);
+  });
+}
+
+SYM_EXPORT auto EpochDomain::enter() -> usize {
+  const auto slot = cpu::current_cpu_hint();
+  auto& state = m_slots.get(slot).m_state;
+
+  auto current = state.load(memory_order_relaxed);
+  u64 desired;
+
+  do {
+    if ((current & READER_MASK) == 0) {
+      desired = (m_epoch.load(memory_order_relaxed) << READER_BITS) | 1;
+    } else {
+      assert_invariant((current & READER_MASK) != READER_MASK);
+      desired = current + 1;
+    }
+  } while (!state.compare_exchange_weak(current, desired, memory_order_seq_cst, memory_order_relaxed));
+
+  return slot;
+}
+
+SYM_EXPORT void EpochDomain::exit(usize slot) { m_slots.get(slot).m_state.fetch_sub(1, memory_order_release); }
+
+SYM_EXPORT auto EpochDomain::try_advance() -> bool {
+  auto epoch = m_epoch.load(memory_order_relaxed);
+  const auto published = (epoch << READER_BITS) >> READER_BITS;
+
+  atomic_thread_fence(memory_order_seq_cst);
+
+  for (usize cpu = 0; cpu < m_slots.length(); cpu++) {
+    const auto state = m_slots.get(cpu).m_state.load(memory_order_relaxed);
+    if ((state & READER_MASK) != 0 && (state >> READER_BITS) != published) {
+      return false;
+    }
+  }
+
+  /* Order the readers' accesses before anything reclaimed under the new epoch */
+  atomic_thread_fence(memory_order_acquire);
+
+  /* Losing the race is fine; someone else advanced it for us */
+  m_epoch.compare_exchange_strong(epoch, epoch + 1, memory_order_release, memory_order_relaxed);
+  return true;
+}
+
+void EpochDomain::push_limbo(Slot& slot, EpochNode* head, EpochNode* tail) {
+  auto* top = slot.m_limbo.load(memory_order_relaxed);
+  do {
+    tail->m_next = top;
+  } while (!slot.m_limbo.compare_exchange_weak(top, head, memory_order_release, memory_order_relaxed));
+}
+
+auto EpochDomain::collect_slot(Slot& slot, bool everything) -> usize {
+  auto* node = slot.m_limbo.exchange(nullptr, memory_order_acquire);
+  if (node == nullptr) {
+    return 0;
+  }
+
+  const auto epoch = m_epoch.load(memory_order_acquire);
+
+  EpochNode* keep_head = nullptr;
+  EpochNode* keep_tail = nullptr;
+  usize reclaimed = 0;
+
+  while (node != nullptr) {
+    auto* next = node->m_next;
+
+    if (everything || epoch - node->m_epoch >= 2) {
+      node->m_reclaim(node);
+      reclaimed++;
+    } else {
+      node->m_next = keep_head;
+      keep_tail = keep_tail == nullptr ? node : keep_tail;
+      keep_head = node;
+    }
+
+    node = next;
+  }
+
+  if (keep_head != nullptr) {
+    push_limbo(slot, keep_head, keep_tail);
+  }
+
+  slot.m_pending.fetch_sub(reclaimed, memory_order_relaxed);
+
+  return reclaimed;
+}
+
+SYM_EXPORT void EpochDomain::retire(EpochNode* node, void (*reclaim)(EpochNode*), void* context) {
+  node->m_reclaim = reclaim;
+  node->m_context = context;
+
+  /* The caller's unlink must be visible before we sample the epoch */
+  atomic_thread_fence(memory_order_seq_cst);
+  node->m_epoch = m_epoch.load(memory_order_relaxed);
+
+  auto& slot = m_slots.local();
+  push_limbo(slot, node, node);
+
+  if (slot.m_pending.fetch_add(1, memory_order_relaxed) + 1 >= COLLECT_THRESHOLD) [[unlikely]] {
+    try_advance();
+    collect_slot(slot, false);
+  }
+}
+
+SYM_EXPORT auto EpochDomain::collect() -> usize {
+  try_advance();
+
+  usize reclaimed = 0;
+  m_slots.for_each([&](Slot& slot) { reclaimed += collect_slot(slot, false); });
+
+  return reclaimed;
+}
+
+SYM_EXPORT void EpochDomain::synchronize() {
+  const auto target = m_epoch.load(memory_order_relaxed) + 2;
+
+  while (m_epoch.load(memory_order_relaxed) < target) {
+    if (!try_advance()) {
+      cpu::ephemeral_pause();
+    }
+  }
+
+  m_slots.for_each([&](Slot& slot) { collect_slot(slot, false); });
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-builtin/Export.hh>
+#include <wesos-cpu/Timing.hh>
+#include <wesos-sync/LockProfile.hh>
+
+using namespace wesos;
+using namespace wesos::sync;
+
+namespace wesos::sync {
+  namespace {
+    enum : u8 { SITE_EMPTY = 0, SITE_CLAIMING = 1, SITE_READY = 2 };
+
+    /* The last entry collects every site that did not fit */
+    LockSite LOCK_SITES_GLOBAL[LOCK_PROFILE_SITES + 1];  // NOLINT(modernize-avoid-c-arrays)
+
+    auto same_site(const SourceLocation& a, const SourceLocation& b) -> bool {
+      return a.file_name() == b.file_name() && a.line_number() == b.line_number();
+    }
+
+    auto site_hash(const SourceLocation& site) -> usize {
+      const auto key = bit_cast<uptr>(site.file_name()) ^ (uptr(site.line_number()) * 0x9e3779b97f4a7c15ULL);
+      return usize(key ^ (key >> 29));
+    }
+  }  // namespace
+}  // namespace wesos::sync
+
+SYM_EXPORT auto LockSite::record_acquire(bool contended, u64 spin_cycles) -> void {
+  m_acquisitions.fetch_add(1, memory_order_relaxed);
+
+  if (contended) {
+    m_contended.fetch_add(1, memory_order_relaxed);
+    m_spin_cycles.fetch_add(spin_cycles, memory_order_relaxed);
+  }
+}
+
+SYM_EXPORT auto LockSite::record_release(u64 hold_cycles) -> void {
+  auto max_hold = m_max_hold_cycles.load(memory_order_relaxed);
+  while (hold_cycles > max_hold &&
+         !m_max_hold_cycles.compare_exchange_weak(max_hold, hold_cycles, memory_order_relaxed, memory_order_relaxed)) {
+  }
+}
+
+SYM_EXPORT auto sync::lock_profile_site(SourceLocation site) -> LockSite& {
+  const auto start = site_hash(site) % LOCK_PROFILE_SITES;
+
+  for (usize probe = 0; probe < LOCK_PROFILE_SITES; probe++) {
+    auto& entry = LOCK_SITES_GLOBAL[(start + probe) % LOCK_PROFILE_SITES];
+
+    u8 state = entry.m_state.load(memory_order_acquire);
+    if (state == SITE_EMPTY &&
+        entry.m_state.compare_exchange_strong(state, SITE_CLAIMING, memory_order_acquire, memory_order_acquire)) {
+      entry.m_site = site;
+      entry.m_state.store(SITE_READY, memory_order_release);
+      return entry;
+    }
+
+    while (state == SITE_CLAIMING) {
+      cpu::ephemeral_pause();
+      state = entry.m_state.load(memory_order_acquire);
+    }
+
+    if (same_site(entry.m_site, site)) {
+      return entry;
+    }
+  }
+
+  return LOCK_SITES_GLOBAL[LOCK_PROFILE_SITES];
+}
+
+SYM_EXPORT auto sync::lock_profile_for_each(void* context, void (*callback)(void*, const LockProfile&)) -> void {
+  for (auto& entry : LOCK_SITES_GLOBAL) {
+    const auto acquisitions = entry.m_acquisitions.load(memory_order_relaxed);
+    if (acquisitions == 0) {
+      continue;
+    }
+
+    const LockProfile profile = {
+        .m_site = entry.m_site,
+        .m_acquisitions = acquisitions,
+        .m_contended = entry.m_contended.load(memory_order_relaxed),
+        .m_spin_cycles = entry.m_spin_cycles.load(memory_order_relaxed),
+        .m_max_hold_cycles = entry.m_max_hold_cycles.load(memory_order_relaxed),
+    };
+
+    callback(context, profile);
+  }
+}
+
+SYM_EXPORT auto sync::lock_profile_reset() -> void {
+  for (auto& entry : LOCK_SITES_GLOBAL) {
+    entry.m_acquisitions.store(0, memory_order_relaxed);
+    entry.m_contended.store(0, memory_order_relaxed);
+    entry.m_spin_cycles.store(0, memory_order_relaxed);
+    entry.m_max_hold_cycles.store(0, memory_order_relaxed);
+  }
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-builtin/Export.hh>
+#include <wesos-cpu/Timing.hh>
+#include <wesos-sync/McsLock.hh>
+
+using namespace wesos;
+using namespace wesos::sync;
+
+/*
+ * m_queue.m_tail is the last node in line: null when the lock is free, &m_queue
+ * when it is held with nobody waiting. m_queue.m_next is the holder's successor.
+ * A waiter's m_tail doubles as its "still waiting" flag.
+ */
+
+SYM_EXPORT void McsLock::lock() {
+  while (true) {
+    auto* prev = m_queue.m_tail.load(memory_order_relaxed);
+
+    if (prev == nullptr) {
+      if (m_queue.m_tail.compare_exchange_weak(prev, &m_queue, memory_order_acquire, memory_order_relaxed)) {
+        return;
+      }
+
+      continue;
+    }
+
+    Node node{waiting(), nullptr};
+    if (!m_queue.m_tail.compare_exchange_weak(prev, &node, memory_order_acq_rel, memory_order_relaxed)) {
+      continue;
+    }
+
+    prev->m_next.store(&node, memory_order_release);
+
+    while (node.m_tail.load(memory_order_acquire) == waiting()) {
+      cpu::ephemeral_pause();
+    }
+
+    /* We hold the lock; move our place in line into the lock before our node goes away */
+    auto* succ = node.m_next.load(memory_order_acquire);
+    if (succ == nullptr) {
+      m_queue.m_next.store(nullptr, memory_order_relaxed);
+
+      auto* expected = &node;
+      if (m_queue.m_tail.compare_exchange_strong(expected, &m_queue, memory_order_acq_rel, memory_order_relaxed)) {
+        return;
+      }
+
+      /* Someone queued behind us and has not linked in yet */
+      while ((succ = node.m_next.load(memory_order_acquire)) == nullptr) {
+        cpu::ephemeral_pause();
+      }
+    }
+
+    m_queue.m_next.store(succ, memory_order_relaxed);
+    return;
+  }
+}
+
+SYM_EXPORT void McsLock::unlock() {
+  auto* succ = m_queue.m_next.load(memory_order_acquire);
+
+  if (succ == nullptr) {
+    auto* expected = &m_queue;
+    if (m_queue.m_tail.compare_exchange_strong(expected, nullptr, memory_order_release, memory_order_relaxed)) {
+      return;
+    }
+
+    while ((succ = m_queue.m_next.load(memory_order_acquire)) == nullptr) {
+      cpu::ephemeral_pause();
+    }
+  }
+
+  succ->m_tail.store(nullptr, memory_order_release);
+}
+
+SYM_EXPORT auto McsLock::try_lock() -> bool {
+  Node* expected = nullptr;
+  return m_queue.m_tail.compare_exchange_strong(expected, &m_queue, memory_order_acquire, memory_order_relaxed);
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-builtin/Export.hh>
+#include <wesos-cpu/Timing.hh>
+#include <wesos-sync/RwSpinLock.hh>
+
+using namespace wesos;
+using namespace wesos::sync;
+
+/*
+ * A reader increments its slot and then loads the writer flag. A writer stores the
+ * flag and then loads the slots. Both pairs are sequentially consistent, so at least
+ * one side always sees the other.
+ */
+
+auto RwSpinLock::readers_drained() const -> bool {
+  for (usize cpu = 0; cpu < m_readers.length(); cpu++) {
+    if (m_readers.get(cpu).load(memory_order_seq_cst) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+SYM_EXPORT auto RwSpinLock::read_lock() -> usize {
+  while (true) {
+    /* Writer preference: don't even announce ourselves while a writer is waiting */
+    while (m_writer.load(memory_order_relaxed)) {
+      cpu::ephemeral_pause();
+    }
+
+    const auto slot = cpu::current_cpu_hint();
+    auto& readers = m_readers.get(slot);
+
+    readers.fetch_add(1, memory_order_seq_cst);
+    if (!m_writer.load(memory_order_seq_cst)) [[likely]] {
+      return slot;
+    }
+
+    readers.fetch_sub(1, memory_order_release);
+  }
+}
+
+SYM_EXPORT void RwSpinLock::read_unlock(usize slot) { m_readers.get(slot).fetch_sub(1, memory_order_release); }
+
+SYM_EXPORT auto RwSpinLock::try_read_lock() -> Nullable<usize> {
+  if (m_writer.load(memory_order_relaxed)) {
+    return null;
+  }
+
+  const auto slot = cpu::current_cpu_hint();
+  auto& readers = m_readers.get(slot);
+
+  readers.fetch_add(1, memory_order_seq_cst);
+  if (!m_writer.load(memory_order_seq_cst)) [[likely]] {
+    return slot;
+  }
+
+  readers.fetch_sub(1, memory_order_release);
+  return null;
+}
+
+SYM_EXPORT void RwSpinLock::lock() {
+  bool expected;
+
+  while (true) {
+    expected = false;
+    if (m_writer.compare_exchange_weak(expected, true, memory_order_seq_cst, memory_order_relaxed)) [[likely]] {
+      break;
+    }
+
+    while (m_writer.load(memory_order_relaxed)) {
+      cpu::ephemeral_pause();
+    }
+  }
+
+  while (!readers_drained()) {
+    cpu::ephemeral_pause();
+  }
+}
+
+SYM_EXPORT void RwSpinLock::unlock() { m_writer.store(false, memory_order_release); }
+
+SYM_EXPORT auto RwSpinLock::try_lock() -> bool {
+  bool expected = false;
+  if (!m_writer.compare_exchange_strong(expected, true, memory_order_seq_cst, memory_order_relaxed)) {
+    return false;
+  }
+
+  if (!readers_drained()) {
+    m_writer.store(false, memory_order_release);
+    return false;
+  }
+
+  return true;
+}
@@ -9,26 +9,78 @@
 #include <wesos-cpu/Timing.hh>
 #include <wesos-sync/SpinLock.hh>
 
+using namespace wesos;
 using namespace wesos::sync;
 
+#if WESOS_LOCK_PROFILING
+SYM_EXPORT auto SpinLock::profile_acquire(bool contended, u64 spin_cycles) -> void {
+  /* Only the holder touches these, so the lock itself orders them */
+  if (m_stats == nullptr) [[unlikely]] {
+    m_stats = &lock_profile_site(m_site);
+  }
+
+  m_stats->record_acquire(contended, spin_cycles);
+  m_acquired_at = cpu::cycle_counter();
+}
+#endif
+
 SYM_EXPORT void SpinLock::lock() {
+  bool expected = false;
+  if (m_locked.compare_exchange_weak(expected, true, memory_order_acquire, memory_order_relaxed)) [[likely]] {
+#if WESOS_LOCK_PROFILING
+    profile_acquire(false, 0);
+#endif
+    return;
+  }
+
+  lock_contended();
+}
+
+SYM_EXPORT void SpinLock::lock_contended() {
+#if WESOS_LOCK_PROFILING
+  const auto spin_start = cpu::cycle_counter();
+#endif
+
+  u32 backoff = BACKOFF_MIN;
   bool expected;
 
   while (true) {
-    expected = false;
-    if (m_locked.compare_exchange_weak(expected, true, memory_order_acquire, memory_order_relaxed)) [[likely]] {
-      return;
+    while (m_locked.load(memory_order_relaxed)) {
+      for (u32 i = 0; i < backoff; i++) {
+        cpu::ephemeral_pause();
+      }
+
+      backoff = min(backoff * 2, BACKOFF_MAX);
     }
 
-    while (m_locked.load(memory_order_relaxed)) {
-      cpu::ephemeral_pause();
+    expected = false;
+    if (m_locked.compare_exchange_weak(expected, true, memory_order_acquire, memory_order_relaxed)) [[likely]] {
+      break;
     }
   }
+
+#if WESOS_LOCK_PROFILING
+  profile_acquire(true, cpu::cycle_counter() - spin_start);
+#endif
 }
 
-SYM_EXPORT void SpinLock::unlock() { m_locked.store(false, memory_order_release); }
+SYM_EXPORT void SpinLock::unlock() {
+#if WESOS_LOCK_PROFILING
+  m_stats->record_release(cpu::cycle_counter() - m_acquired_at);
+#endif
+
+  m_locked.store(false, memory_order_release);
+}
 
 SYM_EXPORT auto SpinLock::try_lock() -> bool {
   bool expected = false;
-  return m_locked.compare_exchange_strong(expected, true, memory_order_acquire, memory_order_relaxed);
+  if (!m_locked.compare_exchange_strong(expected, true, memory_order_acquire, memory_order_relaxed)) {
+    return false;
+  }
+
+#if WESOS_LOCK_PROFILING
+  profile_acquire(false, 0);
+#endif
+
+  return true;
 }
@@ -0,0 +1,42 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <wesos-builtin/Export.hh>
+#include <wesos-cpu/Timing.hh>
+#include <wesos-sync/TicketLock.hh>
+
+using namespace wesos;
+using namespace wesos::sync;
+
+SYM_EXPORT void TicketLock::lock() {
+  const auto ticket = m_next_ticket.fetch_add(1, memory_order_relaxed);
+
+  while (true) {
+    const auto serving = m_now_serving.load(memory_order_acquire);
+    if (serving == ticket) [[likely]] {
+      return;
+    }
+
+    /* Back off in proportion to our place in line */
+    for (u32 i = ticket - serving; i != 0; i--) {
+      cpu::ephemeral_pause();
+    }
+  }
+}
+
+SYM_EXPORT void TicketLock::unlock() {
+  /* Only the holder writes this counter */
+  const auto serving = m_now_serving.load(memory_order_relaxed);
+  m_now_serving.store(serving + 1, memory_order_release);
+}
+
+SYM_EXPORT auto TicketLock::try_lock() -> bool {
+  auto serving = m_now_serving.load(memory_order_acquire);
+
+  /* The lock is free only when nobody holds or waits for a ticket */
+  return m_next_ticket.compare_exchange_strong(serving, serving + 1, memory_order_acquire, memory_order_relaxed);
+}
@@ -0,0 +1,141 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <wesos-sync/Epoch.hh>
+
+using namespace wesos;
+
+namespace {
+  struct Node final : sync::EpochNode {
+    static constexpr u64 LIVE = 0x5afe5afe5afe5afe;
+
+    u64 m_magic = LIVE;
+    usize* m_reclaimed;
+
+    Node(usize* reclaimed) : m_reclaimed(reclaimed) {}
+    Node(const Node&) = delete;
+    Node(Node&&) = delete;
+    auto operator=(const Node&) -> Node& = delete;
+    auto operator=(Node&&) -> Node& = delete;
+    ~Node() {
+      m_magic = 0;
+      ++*m_reclaimed;
+    }
+
+    static void reclaim(sync::EpochNode* node) { delete static_cast<Node*>(node); }
+  };
+
+  struct CountingResource {
+    usize m_deallocations = 0;
+
+    auto deallocate_bytes(void* ptr, usize size, usize align) -> void {
+      ASSERT_EQ(size, sizeof(Node));
+      ASSERT_EQ(align, alignof(Node));
+      ::operator delete(ptr);
+      m_deallocations++;
+    }
+  };
+}  // namespace
+
+/* A moved-from lease would release its slot a second time */
+static_assert(!std::is_move_constructible_v<sync::EpochDomain::ReadLease>);
+
+TEST(Epoch, RetireWaitsForReaders) {
+  usize reclaimed = 0;
+  sync::EpochDomain domain;
+
+  {
+    auto lease = domain.read_lease();
+    domain.retire(new Node(&reclaimed), Node::reclaim);
+
+    for (usize i = 0; i < 8; i++) {
+      domain.collect();
+    }
+
+    ASSERT_EQ(reclaimed, 0);
+  }
+
+  domain.synchronize();
+  ASSERT_EQ(reclaimed, 1);
+}
+
+TEST(Epoch, RetireToResource) {
+  usize reclaimed = 0;
+  CountingResource mm;
+
+  {
+    sync::EpochDomain domain;
+    domain.retire(mm, new (::operator new(sizeof(Node))) Node(&reclaimed));
+    domain.retire(mm, new (::operator new(sizeof(Node))) Node(&reclaimed));
+
+    domain.synchronize();
+    ASSERT_EQ(mm.m_deallocations, 2);
+
+    /* Whatever is left in limbo goes when the domain does */
+    domain.retire(mm, new (::operator new(sizeof(Node))) Node(&reclaimed));
+  }
+
+  ASSERT_EQ(reclaimed, 3);
+  ASSERT_EQ(mm.m_deallocations, 3);
+}
+
+TEST(Epoch, ReadersNeverSeeReclaimedNodes) {
+  constexpr usize reader_count = 3;
+  constexpr usize writes = 2000;
+
+  usize reclaimed = 0;
+  usize retired = 0;
+
+  {
+    sync::EpochDomain domain;
+    sync::Atomic<Node*> current = new Node(&reclaimed);
+    sync::Atomic<bool> done = false;
+    sync::Atomic<usize> torn = 0;
+
+    std::vector<std::thread> readers;
+    for (usize i = 0; i < reader_count; i++) {
+      readers.emplace_back([&] {
+        while (!done.load()) {
+          domain.read_critical_section([&] {
+            if (current.load(sync::memory_order_acquire)->m_magic != Node::LIVE) {
+              torn.fetch_add(1);
+            }
+          });
+
+          std::this_thread::yield();
+        }
+      });
+    }
+
+    for (usize i = 0; i < writes; i++) {
+      auto* old = current.exchange(new Node(&reclaimed), sync::memory_order_acq_rel);
+      domain.retire(old, Node::reclaim);
+      retired++;
+
+      if (i % 64 == 0) {
+        std::this_thread::yield();
+      }
+    }
+
+    done.store(true);
+    for (auto& reader : readers) {
+      reader.join();
+    }
+
+    ASSERT_EQ(torn.load(), 0);
+
+    domain.retire(current.load(), Node::reclaim);
+    retired++;
+  }
+
+  ASSERT_EQ(reclaimed, retired);
+}
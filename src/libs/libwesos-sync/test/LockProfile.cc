@@ -0,0 +1,73 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <wesos-sync/LockProfile.hh>
+#include <wesos-sync/SpinLock.hh>
+
+using namespace wesos;
+
+namespace {
+  auto find_profile(const SourceLocation& site) -> sync::LockProfile {
+    struct Search {
+      const SourceLocation& m_site;
+      sync::LockProfile m_found;
+    } search = {.m_site = site, .m_found = {}};
+
+    sync::lock_profile_for_each(&search, [](void* context, const sync::LockProfile& profile) {
+      auto& search = *static_cast<Search*>(context);
+      if (profile.m_site.file_name() == search.m_site.file_name() &&
+          profile.m_site.line_number() == search.m_site.line_number()) {
+        search.m_found = profile;
+      }
+    });
+
+    return search.m_found;
+  }
+}  // namespace
+
+TEST(LockProfile, SitesAreShared) {
+  const auto site = SourceLocation::current();
+
+  auto& first = sync::lock_profile_site(site);
+  auto& second = sync::lock_profile_site(site);
+  auto& other = sync::lock_profile_site(SourceLocation::current());
+
+  ASSERT_EQ(&first, &second);
+  ASSERT_NE(&first, &other);
+  ASSERT_EQ(first.site().line_number(), site.line_number());
+
+  first.record_acquire(false, 0);
+  first.record_acquire(true, 100);
+  first.record_release(7);
+  second.record_release(5);
+
+  auto profile = find_profile(site);
+  ASSERT_EQ(profile.m_acquisitions, 2);
+  ASSERT_EQ(profile.m_contended, 1);
+  ASSERT_EQ(profile.m_spin_cycles, 100);
+  ASSERT_EQ(profile.m_max_hold_cycles, 7);
+
+  sync::lock_profile_reset();
+  ASSERT_EQ(find_profile(site).m_acquisitions, 0);
+}
+
+#if WESOS_LOCK_PROFILING
+TEST(LockProfile, SpinLockRecords) {
+  const auto site = SourceLocation::current();
+  sync::SpinLock lock(site);
+
+  lock.critical_section([] {});
+  ASSERT_TRUE(lock.try_lock());
+  lock.unlock();
+
+  auto profile = find_profile(site);
+  ASSERT_EQ(profile.m_acquisitions, 2);
+  ASSERT_EQ(profile.m_contended, 0);
+}
+#endif
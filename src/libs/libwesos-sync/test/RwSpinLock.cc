@@ -0,0 +1,79 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <wesos-sync/RwSpinLock.hh>
+
+using namespace wesos;
+
+/* A moved-from lease would release its slot a second time */
+static_assert(!std::is_move_constructible_v<sync::RwSpinLock::ReadLease>);
+
+TEST(RwSpinLock, TryLock) {
+  sync::RwSpinLock lock;
+
+  {
+    auto first = lock.read_lease();
+    auto second = lock.try_read_lock();
+    ASSERT_TRUE(second);
+
+    /* Readers keep writers out */
+    ASSERT_FALSE(lock.try_lock());
+    lock.read_unlock(second.value());
+  }
+
+  ASSERT_TRUE(lock.try_lock());
+  ASSERT_FALSE(lock.try_read_lock());
+  ASSERT_FALSE(lock.try_lock());
+  lock.unlock();
+
+  ASSERT_EQ(lock.read_critical_section([] { return 7; }), 7);
+  ASSERT_EQ(lock.write_critical_section([] { return 9; }), 9);
+}
+
+TEST(RwSpinLock, ReadersSeeConsistentWrites) {
+  constexpr usize reader_count = 3;
+  constexpr usize writes = 500;
+
+  sync::RwSpinLock lock;
+  usize pair[2] = {0, 0};
+  sync::Atomic<bool> done = false;
+  sync::Atomic<usize> torn = 0;
+
+  std::vector<std::thread> readers;
+  for (usize i = 0; i < reader_count; i++) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        lock.read_critical_section([&] {
+          if (pair[0] != pair[1]) {
+            torn.fetch_add(1);
+          }
+        });
+      }
+    });
+  }
+
+  for (usize i = 1; i <= writes; i++) {
+    lock.write_critical_section([&] {
+      pair[0] = i;
+      std::this_thread::yield();
+      pair[1] = i;
+    });
+  }
+
+  done.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  ASSERT_EQ(torn.load(), 0);
+  ASSERT_EQ(pair[1], writes);
+}
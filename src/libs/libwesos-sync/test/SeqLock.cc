@@ -0,0 +1,73 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+#include <wesos-sync/SeqLock.hh>
+
+using namespace wesos;
+
+namespace {
+  struct Sample {
+    u64 m_value;
+    u64 m_inverse;
+    u32 m_tag;
+  };
+}  // namespace
+
+TEST(SeqLock, ReadWrite) {
+  sync::SeqLock<Sample> lock({1, ~u64(1), 3});
+
+  auto sample = lock.read();
+  ASSERT_EQ(sample.m_value, 1);
+  ASSERT_EQ(sample.m_tag, 3);
+
+  lock.write({5, ~u64(5), 7});
+  ASSERT_EQ(lock.try_read().value().m_value, 5);
+
+  lock.update([](Sample& value) { value.m_tag++; });
+  ASSERT_EQ(lock.read().m_tag, 8);
+}
+
+TEST(SeqLock, SnapshotsAreNeverTorn) {
+  constexpr usize reader_count = 3;
+  constexpr u64 writes = 200000;
+
+  sync::SeqLock<Sample> lock({0, ~u64(0), 0});
+  sync::Atomic<bool> done = false;
+  sync::Atomic<usize> torn = 0;
+
+  std::vector<std::thread> readers;
+  for (usize i = 0; i < reader_count; i++) {
+    readers.emplace_back([&] {
+      u64 last = 0;
+
+      while (!done.load()) {
+        const auto sample = lock.read();
+        if (sample.m_inverse != ~sample.m_value || sample.m_tag != u32(sample.m_value) || sample.m_value < last) {
+          torn.fetch_add(1);
+        }
+
+        last = sample.m_value;
+      }
+    });
+  }
+
+  for (u64 i = 1; i <= writes; i++) {
+    lock.write({i, ~i, u32(i)});
+  }
+
+  done.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  ASSERT_EQ(torn.load(), 0);
+  ASSERT_EQ(lock.read().m_value, writes);
+}
@@ -7,8 +7,52 @@
 
 #include <gtest/gtest.h>
 
-#include <wesos-sync/Atomic.hh>
+#include <thread>
+#include <vector>
+#include <wesos-sync/SpinLock.hh>
 
-TEST(SpinLock, NotATest) {
-  // FIXME: Write SpinLock functional test
+using namespace wesos;
+
+TEST(SpinLock, TryLock) {
+  sync::SpinLock lock;
+
+  ASSERT_TRUE(lock.try_lock());
+  ASSERT_FALSE(lock.try_lock());
+  lock.unlock();
+
+  {
+    auto lease = lock.lease();
+    ASSERT_FALSE(lock.try_lease());
+  }
+
+  ASSERT_TRUE(lock.try_critical_section([] { return 1; }));
+}
+
+TEST(SpinLock, MutualExclusion) {
+  constexpr usize thread_count = 4;
+  constexpr usize iterations = 5000;
+
+  sync::SpinLock lock;
+  usize counter = 0;
+  sync::Atomic<usize> ready = 0;
+
+  std::vector<std::thread> threads;
+  for (usize i = 0; i < thread_count; i++) {
+    threads.emplace_back([&] {
+      ready.fetch_add(1);
+      while (ready.load() != thread_count) {
+        std::this_thread::yield();
+      }
+
+      for (usize j = 0; j < iterations; j++) {
+        lock.critical_section([&] { counter = counter + 1; });
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(counter, thread_count * iterations);
 }
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the WesOS project.
+ *
+ * WesOS is public domain software: you can redistribute it and/or modify
+ * it under the terms of the Unlicense(https://unlicense.org/).
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+#include <wesos-sync/TicketLock.hh>
+
+using namespace wesos;
+
+TEST(TicketLock, TryLock) {
+  sync::TicketLock lock;
+
+  ASSERT_TRUE(lock.try_lock());
+  ASSERT_FALSE(lock.try_lock());
+  lock.unlock();
+
+  {
+    auto lease = lock.lease();
+    ASSERT_FALSE(lock.try_lease());
+  }
+
+  ASSERT_TRUE(lock.try_critical_section([] { return 1; }));
+}
+
+TEST(TicketLock, MutualExclusion) {
+  constexpr usize thread_count = 4;
+  constexpr usize iterations = 5000;
+
+  sync::TicketLock lock;
+  usize counter = 0;
+  sync::Atomic<usize> ready = 0;
+
+  std::vector<std::thread> threads;
+  for (usize i = 0; i < thread_count; i++) {
+    threads.emplace_back([&] {
+      /* Start together so the threads really contend */
+      ready.fetch_add(1);
+      while (ready.load() != thread_count) {
+        std::this_thread::yield();
+      }
+
+      for (usize j = 0; j < iterations; j++) {
+        /* A torn read-modify-write shows up as a lost update */
+        lock.critical_section([&] { counter = counter + 1; });
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(counter, thread_count * iterations);
+}
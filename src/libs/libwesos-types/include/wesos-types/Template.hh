@@ -66,6 +66,9 @@ namespace wesos::types {
   template <typename Tp, typename Up>
   inline constexpr bool is_same_v = __is_same(Tp, Up);
 
+  template <typename Base, typename Derived>
+  inline constexpr bool is_base_of_v = __is_base_of(Base, Derived);
+
   template <typename T>
   struct remove_reference {
     using type = T;